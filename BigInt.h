@@ -8,11 +8,17 @@
  *    as source file
  *      #define BIG_INT_IMPLEMENTATION
  *      #include "BigInt.h"
+ *
+ * needs C11 or later, buffer reference counts are C11 atomics
  */
 
 #ifndef BIG_INT_H
 
 #define BIG_INT_H
+#if !defined(__STDC_VERSION__) || __STDC_VERSION__ < 201112L
+#error "BigInt.h needs C11 or later (-std=c11)"
+#endif
+#include <stdatomic.h>
 #include <stdbool.h>
 #include <stdint.h>
 #include <stdlib.h>
@@ -45,22 +51,515 @@ void bigint_to_dec_str(BigInt bigint, char *str_buf, size_t str_buf_size);
 bool bigint_isequal_uint32(BigInt a, uint32_t b);
 void bigint_shallow_copy(BigInt *dst, BigInt *src);
 void bigint_deep_copy(BigInt *dst, BigInt *src);
+BigInt bigint_share(BigInt *src);
+bool bigint_is_shared(BigInt *bigint);
+void bigint_make_unique(BigInt *bigint);
+
+// process wide accounting of the memory held by limb buffers
+typedef struct {
+    size_t current_bytes; // bytes held right now
+    size_t peak_bytes;    // high water mark of current_bytes
+    size_t allocations;   // buffers allocated
+    size_t reallocations; // buffers grown or shrunk
+} BigIntStats;
+
+void bigint_reserve(BigInt *num, uint64_t n_bits);
+void bigint_shrink_to_fit(BigInt *num);
+void bigint_set_growth_policy(unsigned factor_percent, size_t granularity_limbs);
+BigIntStats bigint_get_stats(void);
+void bigint_reset_peak_stats(void);
+
+// ---- execution context ----
+// long running operations take an optional BigIntCtx (NULL for none) and poll it at
+// block boundaries. they stop with BIGINT_CANCELLED, freeing their temporaries and
+// leaving their outputs zero, once the cancel flag is set, the deadline has passed or
+// the progress callback returns false.
+typedef enum {
+    BIGINT_OK = 0,
+    BIGINT_CANCELLED,
+} BigIntStatus;
+
+typedef struct {
+    uint64_t deadline_ns;      // compared against bigint_now_ns(), 0 for no deadline
+    const atomic_bool *cancel; // may be set from any thread, NULL if unused
+    bool (*progress)(uint64_t done, uint64_t total, void *user); // NULL if unused
+    void *user;
+} BigIntCtx;
+
+uint64_t bigint_now_ns(void);
+BigIntStatus bigint_mul_ctx(BigInt *dst, BigInt *a, BigInt *b, BigIntCtx *ctx);
+BigIntStatus bigint_divmod_ctx(BigInt *quo, BigInt *rem, BigInt *a, BigInt *b, BigIntCtx *ctx);
+BigIntStatus bigint_pow_ctx(BigInt *dst, BigInt *base, uint64_t exp, BigIntCtx *ctx);
+BigIntStatus bigint_to_dec_str_ctx(BigInt bigint, char *str_buf, size_t str_buf_size, BigIntCtx *ctx);
+void bigint_mul(BigInt *dst, BigInt *a, BigInt *b);
+void bigint_pow(BigInt *dst, BigInt *base, uint64_t exp);
+void bigint_ui_pow_ui(BigInt *dst, uint32_t base, uint64_t exp);
+void bigint_from_limbs(BigInt *dst, const uint32_t *limbs, size_t n);
+bool bigint_to_limbs(BigInt *src, uint32_t *limbs, size_t n);
+void bigint_set_uint64(BigInt *num, uint64_t value);
+void bigint_set_int64(BigInt *num, int64_t value);
+void bigint_divmod(BigInt *quo, BigInt *rem, BigInt *a, BigInt *b);
+void bigint_sqrt(BigInt *dst, BigInt *a);
+void bigint_and(BigInt *dst, BigInt *a, BigInt *b);
+void bigint_or(BigInt *dst, BigInt *a, BigInt *b);
+void bigint_xor(BigInt *dst, BigInt *a, BigInt *b);
+void bigint_com(BigInt *dst, BigInt *a);
+uint64_t bigint_popcount(BigInt *a);
+uint64_t bigint_hamdist(BigInt *a, BigInt *b);
+uint64_t bigint_scan0(BigInt *a, uint64_t start_bit);
+uint64_t bigint_scan1(BigInt *a, uint64_t start_bit);
+bool bigint_tstbit(BigInt *a, uint64_t bit);
+void bigint_setbit(BigInt *a, uint64_t bit);
+void bigint_clrbit(BigInt *a, uint64_t bit);
+size_t bigint_sizeinbase(BigInt *a, int base);
+
+// ---- division by invariant divisors ----
+// a BigIntDivisor does the per divisor work of a division once: it keeps the divisor normalized
+// (top bit set) with a Möller-Granlund reciprocal of its top limb, so each quotient limb costs a
+// multiply instead of a hardware divide, and from BIGINT_THRESHOLD_BARRETT limbs on the Barrett
+// reciprocal floor(B^2n / d) that turns a division into two multiplications.
+// results truncate like bigint_divmod.
+typedef struct {
+    uint32_t *limbs;  // the divisor shifted left by `shift`
+    uint32_t *mu;     // Barrett reciprocal of limbs in n + 1 limbs, NULL for short divisors
+    size_t n;         // number of limbs
+    uint32_t shift;   // normalization shift
+    uint32_t inv;     // reciprocal of limbs[n - 1]
+    bool is_negative; // sign of the divisor
+} BigIntDivisor;
+
+void bigint_divisor_init(BigIntDivisor *div, BigInt *d);
+void bigint_divisor_free(BigIntDivisor *div);
+void bigint_divmod_pre(BigInt *quo, BigInt *rem, BigInt *a, const BigIntDivisor *div);
+void bigint_mod_pre(BigInt *rem, BigInt *a, const BigIntDivisor *div);
+
+// ---- decimal limbs ----
+// BigIntDec keeps a value in base 10^9 so reading and writing decimal text is linear, for work
+// that mostly parses numbers, adds or scales them and prints them again. everything else goes
+// through an explicit conversion to and from BigInt.
+typedef struct {
+    uint32_t *buf;    // little endian limbs, each below 10^9
+    size_t size;      // limbs in use without leading zeros, 0 for zero
+    size_t capacity;  // allocated limbs
+    bool is_negative; // never set for zero
+} BigIntDec;
+
+BigIntDec bigint_dec_alloc(void);
+void bigint_dec_free(BigIntDec *num);
+void bigint_dec_set(BigIntDec *num, const char *str);
+void bigint_dec_to_str(BigIntDec *num, char *str_buf, size_t str_buf_size);
+size_t bigint_dec_digits(BigIntDec *num);
+int bigint_dec_cmp(BigIntDec *a, BigIntDec *b);
+void bigint_dec_add(BigIntDec *dst, BigIntDec *a, BigIntDec *b);
+void bigint_dec_sub(BigIntDec *dst, BigIntDec *a, BigIntDec *b);
+void bigint_dec_mul_ui(BigIntDec *dst, BigIntDec *a, uint32_t multiplier);
+void bigint_dec_from_bigint(BigIntDec *dst, BigInt *src);
+void bigint_dec_to_bigint(BigInt *dst, BigIntDec *src);
+
+// ---- residue number system ----
+// BigIntRns holds a value as its residues modulo k distinct 31 bit primes, so additions,
+// subtractions and multiplications work on each prime on its own with no carries between them.
+// the _range variants touch only residues [lo, hi), so threads that take disjoint ranges of the
+// same values need no locking and a chain of operations scales with them. values are only known modulo
+// the product M of the primes: a basis for `bits` bits reconstructs exactly every result of
+// magnitude below 2^bits, intermediates may wrap. the basis keeps the product tree of the primes
+// that conversion from BigInt walks as a remainder tree and CRT reconstruction combines bottom up.
+typedef struct {
+    uint32_t *primes;        // k distinct primes between 2^30 and 2^31, largest first
+    uint32_t *inv;           // bigint_limb_reciprocal(primes[i] << 1)
+    uint32_t *crt;           // (M / primes[i])^-1 mod primes[i]
+    size_t k;                // number of primes
+    BigInt *tree;            // product of the primes under each node, node 0 is M
+    BigIntDivisor *tree_div; // the same products prepared for division
+    BigInt half;             // floor(M / 2), larger residues reconstruct as negative values
+} BigIntRnsBasis;
+
+typedef struct {
+    uint32_t *res;               // res[i] is the value mod basis->primes[i]
+    const BigIntRnsBasis *basis; // shared, must outlive the value
+} BigIntRns;
+
+void bigint_rns_basis_init(BigIntRnsBasis *basis, uint64_t bits);
+void bigint_rns_basis_free(BigIntRnsBasis *basis);
+BigIntRns bigint_rns_alloc(const BigIntRnsBasis *basis);
+void bigint_rns_free(BigIntRns *num);
+void bigint_rns_set_int64(BigIntRns *num, int64_t value);
+void bigint_rns_from_bigint(BigIntRns *dst, BigInt *src);
+void bigint_rns_to_bigint(BigInt *dst, BigIntRns *src);
+void bigint_rns_add(BigIntRns *dst, BigIntRns *a, BigIntRns *b);
+void bigint_rns_sub(BigIntRns *dst, BigIntRns *a, BigIntRns *b);
+void bigint_rns_mul(BigIntRns *dst, BigIntRns *a, BigIntRns *b);
+void bigint_rns_add_range(BigIntRns *dst, BigIntRns *a, BigIntRns *b, size_t lo, size_t hi);
+void bigint_rns_sub_range(BigIntRns *dst, BigIntRns *a, BigIntRns *b, size_t lo, size_t hi);
+void bigint_rns_mul_range(BigIntRns *dst, BigIntRns *a, BigIntRns *b, size_t lo, size_t hi);
+
+// ---- algorithm thresholds ----
+// operand sizes in limbs at which the library switches to an asymptotically faster algorithm.
+// the compile time defaults come from bigint_tuned.h when one is on the include path (the
+// bigint-tune tool measures them on the current machine and writes it), each can be overridden
+// per process by an environment variable named like its macro, read on first use, and
+// bigint_set_threshold changes them at runtime. thresholds are shared by all threads.
+typedef enum {
+    BIGINT_THRESHOLD_KARATSUBA_MUL, // BIGINT_KARATSUBA_MUL_THRESHOLD, smaller operand of a product
+    BIGINT_THRESHOLD_KARATSUBA_SQR, // BIGINT_KARATSUBA_SQR_THRESHOLD, operand of a square
+    BIGINT_THRESHOLD_BARRETT,       // BIGINT_BARRETT_THRESHOLD, divisor in bigint_divisor_init
+    BIGINT_THRESHOLD_COUNT,
+} BigIntThreshold;
+
+const char *bigint_threshold_name(BigIntThreshold which);
+size_t bigint_get_threshold(BigIntThreshold which);
+// 0 goes back to the environment or compile time default
+void bigint_set_threshold(BigIntThreshold which, size_t limbs);
+
+// ---- binary splitting ----
+// evaluates S = sum_{n=n1}^{n2-1} a(n)/b(n) * p(n1)...p(n)/(q(n1)...q(n)) as T / (B * Q)
+// by recursively combining halves. `term` fills p, q, a and b for a single n, b is only
+// used (and only needs to be set) when `uses_b` is true. up to `threads` subtrees are
+// evaluated in parallel when the library is built with BIGINT_THREADS.
+typedef struct {
+    void (*term)(uint64_t n, BigInt *p, BigInt *q, BigInt *a, BigInt *b, void *user);
+    void *user;
+    bool uses_b;
+    unsigned threads;
+} BigIntSeries;
+
+void bigint_binsplit(BigIntSeries *series, uint64_t n1, uint64_t n2, BigInt *P, BigInt *Q, BigInt *B, BigInt *T);
+void bigint_const_pi(BigInt *dst, uint64_t digits, unsigned threads);
+void bigint_const_e(BigInt *dst, uint64_t digits, unsigned threads);
+void bigint_const_ln2(BigInt *dst, uint64_t digits, unsigned threads);
+
+// ---- fixed width unsigned integers ----
+// BIGINT_DEFINE_FIXED(BITS) generates BigUInt<BITS> and its biguint<BITS>_* kernels.
+// values live on the stack and wrap around modulo 2^BITS, every loop has a
+// compile time trip count and is fully unrolled, nothing here ever allocates. compares and
+// shifts select with masks instead of branching on the values or the shift amount.
+
+#if defined(__GNUC__)
+#define BIGINT_UNROLL _Pragma("GCC unroll 64")
+#else
+#define BIGINT_UNROLL
+#endif
+
+#define BIGINT_DEFINE_FIXED(BITS)                                                                  \
+    typedef struct {                                                                               \
+        uint32_t limb[(BITS) / 32];                                                                \
+    } BigUInt##BITS;                                                                               \
+                                                                                                   \
+    enum { BIGUINT##BITS##_LIMBS = (BITS) / 32 };                                                  \
+                                                                                                   \
+    static inline void biguint##BITS##_set_zero(BigUInt##BITS *r) {                                \
+        BIGINT_UNROLL                                                                              \
+        for (int i = 0; i < BIGUINT##BITS##_LIMBS; i++) r->limb[i] = 0;                            \
+    }                                                                                              \
+                                                                                                   \
+    static inline void biguint##BITS##_set_uint64(BigUInt##BITS *r, uint64_t v) {                  \
+        biguint##BITS##_set_zero(r);                                                               \
+        r->limb[0] = (uint32_t)v;                                                                  \
+        r->limb[1] = (uint32_t)(v >> 32);                                                          \
+    }                                                                                              \
+                                                                                                   \
+    static inline bool biguint##BITS##_is_zero(const BigUInt##BITS *a) {                           \
+        uint32_t acc = 0;                                                                          \
+        BIGINT_UNROLL                                                                              \
+        for (int i = 0; i < BIGUINT##BITS##_LIMBS; i++) acc |= a->limb[i];                         \
+        return acc == 0;                                                                           \
+    }                                                                                              \
+                                                                                                   \
+    /* returns -1, 0 or 1 like memcmp, the top limb that differs decides, without a branch */      \
+    static inline int biguint##BITS##_cmp(const BigUInt##BITS *a, const BigUInt##BITS *b) {        \
+        uint32_t gt = 0, lt = 0;                                                                   \
+        BIGINT_UNROLL                                                                              \
+        for (int i = BIGUINT##BITS##_LIMBS - 1; i >= 0; i--) {                                     \
+            uint32_t open = 1 ^ (gt | lt);                                                         \
+            gt |= open & (uint32_t)(a->limb[i] > b->limb[i]);                                      \
+            lt |= open & (uint32_t)(a->limb[i] < b->limb[i]);                                      \
+        }                                                                                          \
+        return (int)gt - (int)lt;                                                                  \
+    }                                                                                              \
+                                                                                                   \
+    /* r = a + b, returns the carry out of the top limb, r may alias a or b */                     \
+    static inline uint32_t biguint##BITS##_add(BigUInt##BITS *r, const BigUInt##BITS *a,           \
+                                               const BigUInt##BITS *b) {                           \
+        uint64_t carry = 0;                                                                        \
+        BIGINT_UNROLL                                                                              \
+        for (int i = 0; i < BIGUINT##BITS##_LIMBS; i++) {                                          \
+            carry += (uint64_t)a->limb[i] + b->limb[i];                                            \
+            r->limb[i] = (uint32_t)carry;                                                          \
+            carry >>= 32;                                                                          \
+        }                                                                                          \
+        return (uint32_t)carry;                                                                    \
+    }                                                                                              \
+                                                                                                   \
+    /* r = a - b, returns 1 if it borrowed past the top limb, r may alias a or b */                \
+    static inline uint32_t biguint##BITS##_sub(BigUInt##BITS *r, const BigUInt##BITS *a,           \
+                                               const BigUInt##BITS *b) {                           \
+        uint64_t borrow = 0;                                                                       \
+        BIGINT_UNROLL                                                                              \
+        for (int i = 0; i < BIGUINT##BITS##_LIMBS; i++) {                                          \
+            uint64_t diff = (uint64_t)a->limb[i] - b->limb[i] - borrow;                            \
+            r->limb[i] = (uint32_t)diff;                                                           \
+            borrow = (diff >> 32) & 1;                                                             \
+        }                                                                                          \
+        return (uint32_t)borrow;                                                                   \
+    }                                                                                              \
+                                                                                                   \
+    /* lo, hi = a * b as a double width product, lo and hi may alias a or b */                     \
+    static inline void biguint##BITS##_mul_wide(BigUInt##BITS *lo, BigUInt##BITS *hi,              \
+                                                const BigUInt##BITS *a, const BigUInt##BITS *b) {  \
+        uint32_t t[2 * BIGUINT##BITS##_LIMBS] = {0};                                               \
+        BIGINT_UNROLL                                                                              \
+        for (int i = 0; i < BIGUINT##BITS##_LIMBS; i++) {                                          \
+            uint64_t carry = 0;                                                                    \
+            BIGINT_UNROLL                                                                          \
+            for (int j = 0; j < BIGUINT##BITS##_LIMBS; j++) {                                      \
+                carry += (uint64_t)a->limb[i] * b->limb[j] + t[i + j];                             \
+                t[i + j] = (uint32_t)carry;                                                        \
+                carry >>= 32;                                                                      \
+            }                                                                                      \
+            t[i + BIGUINT##BITS##_LIMBS] = (uint32_t)carry;                                        \
+        }                                                                                          \
+        BIGINT_UNROLL                                                                              \
+        for (int i = 0; i < BIGUINT##BITS##_LIMBS; i++) {                                          \
+            lo->limb[i] = t[i];                                                                    \
+            hi->limb[i] = t[i + BIGUINT##BITS##_LIMBS];                                            \
+        }                                                                                          \
+    }                                                                                              \
+                                                                                                   \
+    /* r = a * b mod 2^BITS, only the low half of the product is computed */                       \
+    static inline void biguint##BITS##_mul(BigUInt##BITS *r, const BigUInt##BITS *a,               \
+                                           const BigUInt##BITS *b) {                               \
+        uint32_t t[BIGUINT##BITS##_LIMBS] = {0};                                                   \
+        BIGINT_UNROLL                                                                              \
+        for (int i = 0; i < BIGUINT##BITS##_LIMBS; i++) {                                          \
+            uint64_t carry = 0;                                                                    \
+            BIGINT_UNROLL                                                                          \
+            for (int j = 0; i + j < BIGUINT##BITS##_LIMBS; j++) {                                  \
+                carry += (uint64_t)a->limb[i] * b->limb[j] + t[i + j];                             \
+                t[i + j] = (uint32_t)carry;                                                        \
+                carry >>= 32;                                                                      \
+            }                                                                                      \
+        }                                                                                          \
+        BIGINT_UNROLL                                                                              \
+        for (int i = 0; i < BIGUINT##BITS##_LIMBS; i++) r->limb[i] = t[i];                         \
+    }                                                                                              \
+                                                                                                   \
+    /* r = a << shift_by mod 2^BITS, any shift_by is allowed, r may alias a. the bits within a */  \
+    /* limb are shifted first, (x >> 1) >> (31 - bits) is x >> (32 - bits) without shifting by */  \
+    /* 32 when bits is 0, then whole limbs move through one masked select per bit of the limb */   \
+    /* count, so the shift amount never decides a branch */                                        \
+    static inline void biguint##BITS##_left_shift(BigUInt##BITS *r, const BigUInt##BITS *a,        \
+                                                  uint32_t shift_by) {                             \
+        uint32_t t[BIGUINT##BITS##_LIMBS];                                                         \
+        uint32_t limbs = shift_by / 32;                                                            \
+        uint32_t bits = shift_by % 32;                                                             \
+        uint32_t keep = (uint32_t)0 - (uint32_t)(shift_by < (BITS));                               \
+        t[0] = a->limb[0] << bits;                                                                 \
+        BIGINT_UNROLL                                                                              \
+        for (int i = 1; i < BIGUINT##BITS##_LIMBS; i++) {                                          \
+            t[i] = a->limb[i] << bits | (a->limb[i - 1] >> 1) >> (31 - bits);                      \
+        }                                                                                          \
+        BIGINT_UNROLL                                                                              \
+        for (int k = 1; k < BIGUINT##BITS##_LIMBS; k *= 2) {                                       \
+            uint32_t take = (uint32_t)0 - (uint32_t)((limbs & k) != 0);                            \
+            BIGINT_UNROLL                                                                          \
+            for (int i = BIGUINT##BITS##_LIMBS - 1; i >= 0; i--) {                                 \
+                uint32_t moved = i >= k ? t[i - k] : 0;                                            \
+                t[i] = (t[i] & ~take) | (moved & take);                                            \
+            }                                                                                      \
+        }                                                                                          \
+        BIGINT_UNROLL                                                                              \
+        for (int i = 0; i < BIGUINT##BITS##_LIMBS; i++) r->limb[i] = t[i] & keep;                  \
+    }                                                                                              \
+                                                                                                   \
+    /* r = a >> shift_by, any shift_by is allowed, r may alias a, mirrors left_shift */            \
+    static inline void biguint##BITS##_right_shift(BigUInt##BITS *r, const BigUInt##BITS *a,       \
+                                                   uint32_t shift_by) {                            \
+        uint32_t t[BIGUINT##BITS##_LIMBS];                                                         \
+        uint32_t limbs = shift_by / 32;                                                            \
+        uint32_t bits = shift_by % 32;                                                             \
+        uint32_t keep = (uint32_t)0 - (uint32_t)(shift_by < (BITS));                               \
+        t[BIGUINT##BITS##_LIMBS - 1] = a->limb[BIGUINT##BITS##_LIMBS - 1] >> bits;                 \
+        BIGINT_UNROLL                                                                              \
+        for (int i = 0; i < BIGUINT##BITS##_LIMBS - 1; i++) {                                      \
+            t[i] = a->limb[i] >> bits | (a->limb[i + 1] << 1) << (31 - bits);                      \
+        }                                                                                          \
+        BIGINT_UNROLL                                                                              \
+        for (int k = 1; k < BIGUINT##BITS##_LIMBS; k *= 2) {                                       \
+            uint32_t take = (uint32_t)0 - (uint32_t)((limbs & k) != 0);                            \
+            BIGINT_UNROLL                                                                          \
+            for (int i = 0; i < BIGUINT##BITS##_LIMBS; i++) {                                      \
+                uint32_t moved = i + k < BIGUINT##BITS##_LIMBS ? t[i + k] : 0;                     \
+                t[i] = (t[i] & ~take) | (moved & take);                                            \
+            }                                                                                      \
+        }                                                                                          \
+        BIGINT_UNROLL                                                                              \
+        for (int i = 0; i < BIGUINT##BITS##_LIMBS; i++) r->limb[i] = t[i] & keep;                  \
+    }                                                                                              \
+                                                                                                   \
+    /* loads a BigInt modulo 2^BITS (two's complement for negative values), */                     \
+    /* returns false if the value was negative or did not fit */                                   \
+    static inline bool biguint##BITS##_from_bigint(BigUInt##BITS *r, BigInt *src) {               \
+        bool fits = bigint_to_limbs(src, r->limb, BIGUINT##BITS##_LIMBS);                          \
+        if (src->is_negative) {                                                                    \
+            BigUInt##BITS zero;                                                                    \
+            biguint##BITS##_set_zero(&zero);                                                       \
+            biguint##BITS##_sub(r, &zero, r);                                                      \
+            return biguint##BITS##_is_zero(r) && fits;                                             \
+        }                                                                                          \
+        return fits;                                                                               \
+    }                                                                                              \
+                                                                                                   \
+    static inline void biguint##BITS##_to_bigint(BigInt *dst, const BigUInt##BITS *a) {            \
+        bigint_from_limbs(dst, a->limb, BIGUINT##BITS##_LIMBS);                                    \
+    }
+
+BIGINT_DEFINE_FIXED(128)
+BIGINT_DEFINE_FIXED(256)
+BIGINT_DEFINE_FIXED(512)
+BIGINT_DEFINE_FIXED(1024)
 #endif
 
 #define BIG_INT_IMPLEMENTATION // TODO: REMOVE
 
 #ifdef BIG_INT_IMPLEMENTATION
 #include <assert.h>
+#include <stdatomic.h>
 #include <stdint.h>
 #include <stdio.h>
 #include <string.h>
+#include <time.h>
+#ifdef BIGINT_THREADS
+#include <pthread.h>
+#endif
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
 
 #define BASE 32
 #define INIT_SIZE 16
 
+// ---- algorithm thresholds ----
+// machine specific values measured by bigint-tune, anything defined before this point wins
+#if defined(__has_include)
+#if __has_include("bigint_tuned.h")
+#include "bigint_tuned.h"
+#endif
+#endif
+
+// products whose smaller operand has at least this many limbs split into three half size
+// products (Karatsuba), squares split from BIGINT_KARATSUBA_SQR_THRESHOLD limbs on
+#ifndef BIGINT_KARATSUBA_MUL_THRESHOLD
+#define BIGINT_KARATSUBA_MUL_THRESHOLD 32
+#endif
+#ifndef BIGINT_KARATSUBA_SQR_THRESHOLD
+#define BIGINT_KARATSUBA_SQR_THRESHOLD 64
+#endif
+
+// divisors of at least this many limbs get a Barrett reciprocal in bigint_divisor_init.
+// Barrett costs two multiplications per block of quotient limbs and only beats Knuth
+// division once those are well into the Karatsuba range
+#ifndef BIGINT_BARRETT_THRESHOLD
+#define BIGINT_BARRETT_THRESHOLD 384
+#endif
+
+// ---- buffer management ----
+// every limb buffer is preceded by a header holding an atomic reference count.
+// copies made with bigint_share/bigint_shallow_copy point at the same buffer and
+// the first mutation through any of them detaches it with bigint_make_unique.
+
+typedef struct {
+    atomic_size_t refcount;
+    size_t capacity; // in limbs, kept here so a release knows how much memory it returns
+} BigIntBufHeader;
+
+#define BIGINT_HEADER(buf) ((BigIntBufHeader *)(buf) - 1)
+
+static atomic_size_t bigint_stat_current_bytes;
+static atomic_size_t bigint_stat_peak_bytes;
+static atomic_size_t bigint_stat_allocations;
+static atomic_size_t bigint_stat_reallocations;
+
+// growth of an existing buffer, capacity is multiplied by factor_percent / 100 and rounded
+// up to a multiple of granularity limbs
+static atomic_uint bigint_growth_percent = 200;
+static atomic_size_t bigint_growth_granularity = 1;
+
+static void bigint_stat_account(size_t added, size_t removed) {
+    size_t now = atomic_fetch_add_explicit(&bigint_stat_current_bytes, added - removed, memory_order_relaxed) + added - removed;
+    size_t peak = atomic_load_explicit(&bigint_stat_peak_bytes, memory_order_relaxed);
+    while (now > peak && !atomic_compare_exchange_weak_explicit(&bigint_stat_peak_bytes, &peak, now,
+                                                                memory_order_relaxed, memory_order_relaxed)) {
+    }
+}
+
+static uint32_t *bigint_buf_alloc(size_t limbs) {
+    BigIntBufHeader *header = (BigIntBufHeader *)calloc(1, sizeof(BigIntBufHeader) + limbs * sizeof(uint32_t));
+    assert(header != NULL && "memory allocation failed");
+    atomic_init(&header->refcount, 1);
+    header->capacity = limbs;
+    atomic_fetch_add_explicit(&bigint_stat_allocations, 1, memory_order_relaxed);
+    bigint_stat_account(limbs * sizeof(uint32_t), 0);
+    return (uint32_t *)(header + 1);
+}
+
+// resizes an unshared buffer, new limbs are zeroed. a freed or zero initialised value
+// has no buffer yet and gets a fresh one
+static uint32_t *bigint_buf_realloc(uint32_t *buf, size_t old_cap, size_t new_cap) {
+    if (buf == NULL) return bigint_buf_alloc(new_cap);
+    BigIntBufHeader *header = (BigIntBufHeader *)realloc(BIGINT_HEADER(buf), sizeof(BigIntBufHeader) + new_cap * sizeof(uint32_t));
+    assert(header != NULL && "memory allocation failed");
+    header->capacity = new_cap;
+    buf = (uint32_t *)(header + 1);
+    if (new_cap > old_cap) {
+        memset(buf + old_cap, 0, (new_cap - old_cap) * sizeof(uint32_t));
+    }
+    atomic_fetch_add_explicit(&bigint_stat_reallocations, 1, memory_order_relaxed);
+    bigint_stat_account(new_cap * sizeof(uint32_t), old_cap * sizeof(uint32_t));
+    return buf;
+}
+
+static void bigint_buf_release(uint32_t *buf) {
+    if (buf == NULL) return;
+    BigIntBufHeader *header = BIGINT_HEADER(buf);
+    if (atomic_fetch_sub_explicit(&header->refcount, 1, memory_order_acq_rel) == 1) {
+        bigint_stat_account(0, header->capacity * sizeof(uint32_t));
+        free(header);
+    }
+}
+
+// capacity a buffer of `capacity` limbs grows to when it runs out of room
+static size_t bigint_grown_capacity(size_t capacity) {
+    size_t percent = atomic_load_explicit(&bigint_growth_percent, memory_order_relaxed);
+    size_t granularity = atomic_load_explicit(&bigint_growth_granularity, memory_order_relaxed);
+    size_t grown = capacity / 100 * percent + capacity % 100 * percent / 100;
+    if (grown <= capacity) grown = capacity + 1;
+    return (grown + granularity - 1) / granularity * granularity;
+}
+
+void bigint_set_growth_policy(unsigned factor_percent, size_t granularity_limbs) {
+    assert(factor_percent > 100 && "growth factor must be larger than 100%");
+    atomic_store_explicit(&bigint_growth_percent, factor_percent, memory_order_relaxed);
+    atomic_store_explicit(&bigint_growth_granularity, granularity_limbs ? granularity_limbs : 1, memory_order_relaxed);
+}
+
+BigIntStats bigint_get_stats(void) {
+    BigIntStats stats;
+    stats.current_bytes = atomic_load_explicit(&bigint_stat_current_bytes, memory_order_relaxed);
+    stats.peak_bytes = atomic_load_explicit(&bigint_stat_peak_bytes, memory_order_relaxed);
+    stats.allocations = atomic_load_explicit(&bigint_stat_allocations, memory_order_relaxed);
+    stats.reallocations = atomic_load_explicit(&bigint_stat_reallocations, memory_order_relaxed);
+    return stats;
+}
+
+// restarts the high water mark from what is currently held
+void bigint_reset_peak_stats(void) {
+    atomic_store_explicit(&bigint_stat_peak_bytes, atomic_load_explicit(&bigint_stat_current_bytes, memory_order_relaxed),
+                          memory_order_relaxed);
+}
+
 BigInt bigint_alloc() {
     BigInt new_int;
-    new_int.buf = (uint32_t *)calloc(1, INIT_SIZE * sizeof(uint32_t));
+    new_int.buf = bigint_buf_alloc(INIT_SIZE);
     new_int.size = 1;
     new_int.capacity = INIT_SIZE;
     new_int.is_negative = 0;
@@ -68,22 +567,44 @@ BigInt bigint_alloc() {
 }
 
 void bigint_clear(BigInt *bigint) {
-    free(bigint->buf);
-    bigint->buf = (uint32_t *)calloc(1, INIT_SIZE * sizeof(uint32_t));
-    assert(bigint->buf != NULL && "memory allocation failed");
+    bigint_buf_release(bigint->buf);
+    bigint->buf = bigint_buf_alloc(INIT_SIZE);
     bigint->size = 1;
     bigint->capacity = INIT_SIZE;
     bigint->is_negative = 0;
 }
 
 void bigint_free(BigInt *bigint) {
-    free(bigint->buf);
+    bigint_buf_release(bigint->buf);
+    bigint->buf = NULL;
     bigint->size = 0;
     bigint->capacity = 0;
     bigint->is_negative = 0;
 }
 
+bool bigint_is_shared(BigInt *bigint) {
+    return bigint->buf != NULL &&
+           atomic_load_explicit(&BIGINT_HEADER(bigint->buf)->refcount, memory_order_acquire) > 1;
+}
+
+// gives `bigint` a private copy of its buffer if anyone else still references it
+void bigint_make_unique(BigInt *bigint) {
+    if (!bigint_is_shared(bigint)) return;
+
+    uint32_t *buf = bigint_buf_alloc(bigint->capacity);
+    memcpy(buf, bigint->buf, bigint->size * sizeof(uint32_t));
+    bigint_buf_release(bigint->buf);
+    bigint->buf = buf;
+}
+
+// returns a new handle to the same value in O(1), the buffer is copied on first write
+BigInt bigint_share(BigInt *src) {
+    atomic_fetch_add_explicit(&BIGINT_HEADER(src->buf)->refcount, 1, memory_order_relaxed);
+    return *src;
+}
+
 void bigint_set_zero(BigInt *bigint) {
+    bigint_make_unique(bigint);
     bigint->is_negative = 0;
     for(size_t i = 0; i < bigint->size; i++) {
         bigint->buf[i] = 0;
@@ -97,14 +618,19 @@ void bigint_set(BigInt *num, char *arr) {
     if(strcmp(arr, "0") == 0) return;
 
     int start_idx = 0;
+    bool is_negative = false;
     if(arr[0] == '-') {
-        num->is_negative = 1;
+        is_negative = true;
         start_idx = 1;
     }
     
+    // log2(10) < 3.33 bits per digit, presize so the parse never reallocates
+    size_t len = strlen(arr);
+    bigint_reserve(num, (uint64_t)(len - start_idx) * 333 / 100 + 1);
+
     num->size = 1;
     bigint_increment_size(num);
-    for (size_t i = start_idx; i < strlen(arr); i++) {
+    for (size_t i = start_idx; i < len; i++) {
         // TODO: add a check here for numeric char
         // convert char to digit
         uint32_t digit = arr[i] - '0';
@@ -115,6 +641,18 @@ void bigint_set(BigInt *num, char *arr) {
         // add digit to BigInt
         naive_add(num, digit);
     }
+    // the sign goes on last so the digits above accumulate into the magnitude
+    num->is_negative = is_negative && !bigint_isequal_uint32(*num, 0);
+}
+
+void bigint_set_uint64(BigInt *num, uint64_t value) {
+    uint32_t limbs[2] = {(uint32_t)value, (uint32_t)(value >> 32)};
+    bigint_from_limbs(num, limbs, 2);
+}
+
+void bigint_set_int64(BigInt *num, int64_t value) {
+    bigint_set_uint64(num, value < 0 ? -(uint64_t)value : (uint64_t)value);
+    num->is_negative = value < 0;
 }
 
 // this function should not be used outside and is private to the library
@@ -127,261 +665,2469 @@ void bigint_increment_size(BigInt *bigint) {
 
 void bigint_expand(BigInt *num) {
     size_t old_cap = num->capacity;
-    size_t added_bytes = num->capacity;
 
-    num->capacity *= 2;
-    num->buf = (uint32_t *)realloc(num->buf, num->capacity * sizeof(uint32_t));
-    assert(num->buf != NULL && "buy more ram bro\n");
-
-    memset(num->buf + old_cap, 0, added_bytes);
+    bigint_make_unique(num);
+    num->capacity = bigint_grown_capacity(old_cap);
+    num->buf = bigint_buf_realloc(num->buf, old_cap, num->capacity);
 }
 
-void bigint_add(BigInt *dst, BigInt *a, BigInt *b) {
-    bigint_clear(dst);
+// ---- execution context ----
 
-    uint32_t carry = 0, a_curr = 0, b_curr = 0;
-    size_t n = (a->size > b->size ? a->size : b->size);
-    for (size_t i = 0; i < n; i++) {
-        if (i < a->size)
-            a_curr = a->buf[i];
-        else
-            a_curr = 0;
-
-        if (i < b->size)
-            b_curr = b->buf[i];
-        else
-            b_curr = 0;
-
-        // store sum in 64 bit variable
-        uint64_t sum = (uint64_t)a_curr + b_curr + carry;
-        // store lower 32 bits at i th place
-        dst->buf[i] = (uint32_t)(sum & 0xFFFFFFFF);
-        // store higher 32 bits in carry
-        carry = (uint32_t)(sum >> 32);
+// limb products (or limb divisions) between two polls of a BigIntCtx, a few tens of microseconds
+#define BIGINT_CTX_POLL_WORK (1 << 16)
 
-        if (BIGINT_GUARD(dst) != 0) {
-            bigint_increment_size(dst);
-        }
-    }
+// the monotonic clock is POSIX, strict ISO C builds (-std=c11) only get the C11 wall clock
+uint64_t bigint_now_ns(void) {
+    struct timespec ts;
+#ifdef CLOCK_MONOTONIC
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+#else
+    timespec_get(&ts, TIME_UTC);
+#endif
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
 }
 
-// TODO: add support for negative
-void naive_add(BigInt *dest, uint32_t operand) {
-    // store addition of least significant digit and operand in 64 bit variable
-    uint64_t sum = (uint64_t)dest->buf[0] + operand;
-    // store lower 32 bits at 0 th place
-    dest->buf[0] = (uint32_t)(sum & 0xFFFFFFFF);
-    // store higher 32 bits in carry for next iteration
-    uint32_t carry = (uint32_t)(sum >> 32);
+// returns true if the operation owning ctx should stop
+static bool bigint_ctx_poll(BigIntCtx *ctx, uint64_t done, uint64_t total) {
+    if (ctx == NULL) return false;
+    if (ctx->cancel && atomic_load_explicit(ctx->cancel, memory_order_relaxed)) return true;
+    if (ctx->deadline_ns && bigint_now_ns() >= ctx->deadline_ns) return true;
+    if (ctx->progress && !ctx->progress(done, total, ctx->user)) return true;
+    return false;
+}
 
-    // propogate carry
-    size_t i = 0;
-    while (carry != 0) {
-        i++;
-        // add carry to next digit
-        uint64_t temp = (uint64_t)dest->buf[i] + carry;
-        // store lower 32 bits at i th place
-        dest->buf[i] = (uint32_t)(temp & 0xFFFFFFFF);
-        // update carry
-        carry = (uint32_t)(temp >> 32);
+// copy of ctx for the kernels of a composite operation, they keep checking the cancel
+// flag and deadline while the operation itself reports progress in its own units
+static BigIntCtx *bigint_ctx_inner(BigIntCtx *ctx, BigIntCtx *inner) {
+    if (ctx == NULL) return NULL;
+    *inner = *ctx;
+    inner->progress = NULL;
+    return inner;
+}
 
-        if (BIGINT_GUARD(dest) != 0) {
-            bigint_increment_size(dest);
-        }
+// ---- algorithm thresholds ----
+
+static const char *const bigint_threshold_names[BIGINT_THRESHOLD_COUNT] = {
+    "BIGINT_KARATSUBA_MUL_THRESHOLD",
+    "BIGINT_KARATSUBA_SQR_THRESHOLD",
+    "BIGINT_BARRETT_THRESHOLD",
+};
+
+static const size_t bigint_threshold_defaults[BIGINT_THRESHOLD_COUNT] = {
+    BIGINT_KARATSUBA_MUL_THRESHOLD,
+    BIGINT_KARATSUBA_SQR_THRESHOLD,
+    BIGINT_BARRETT_THRESHOLD,
+};
+
+// current values, 0 until the first bigint_get_threshold
+static atomic_size_t bigint_thresholds[BIGINT_THRESHOLD_COUNT];
+
+const char *bigint_threshold_name(BigIntThreshold which) {
+    assert(which < BIGINT_THRESHOLD_COUNT && "unknown threshold");
+    return bigint_threshold_names[which];
+}
+
+// the environment variable named like the macro when it holds a positive number, else the default
+static size_t bigint_threshold_load(BigIntThreshold which) {
+    const char *env = getenv(bigint_threshold_names[which]);
+    if (env != NULL && *env >= '0' && *env <= '9') {
+        char *end;
+        unsigned long long limbs = strtoull(env, &end, 10);
+        if (*end == '\0' && limbs > 0) return limbs > SIZE_MAX ? SIZE_MAX : (size_t)limbs;
     }
+    return bigint_threshold_defaults[which];
 }
 
-void bigint_sub(BigInt *dst, BigInt *a, BigInt *b) {
-    // TODO: signed number support
-    bigint_clear(dst);
-    bigint_mem_dump(*a);
-    bigint_mem_dump(*b);
+size_t bigint_get_threshold(BigIntThreshold which) {
+    assert(which < BIGINT_THRESHOLD_COUNT && "unknown threshold");
+    size_t limbs = atomic_load_explicit(&bigint_thresholds[which], memory_order_relaxed);
+    if (limbs == 0) {
+        limbs = bigint_threshold_load(which);
+        atomic_store_explicit(&bigint_thresholds[which], limbs, memory_order_relaxed);
+    }
+    return limbs;
+}
 
+void bigint_set_threshold(BigIntThreshold which, size_t limbs) {
+    assert(which < BIGINT_THRESHOLD_COUNT && "unknown threshold");
+    if (limbs == 0) limbs = bigint_threshold_load(which);
+    atomic_store_explicit(&bigint_thresholds[which], limbs, memory_order_relaxed);
+}
 
-    uint64_t carry = 0;
-    size_t len = (a->size > b->size ? a->size : b->size) - 1;
-    for (size_t i = 0; i < len; i++) {
-        // Take a carry from next number (it is assumed that a > b)
-        uint64_t x = 0;
-        uint64_t y = 0;
-        if(i < a->size) x = a->buf[i];
-        if(i < b->size) y = b->buf[i];
-        // check if carry was used in last operation
-        if(carry) {
-            if(x == 0) {
-                carry = (1ULL << BASE) - 1;
-            } else {
-                x--;
-                if(x < y) {
-                    carry = 1ULL << BASE;
-                } else {
-                    carry = 0;
-                }
-            }
-        } else if(x < y){
-            carry = 1ULL << BASE;
-        }
-        uint64_t res = x + carry - y;
-        dst->buf[i] = res;
-        printf("%2zu :%10lu + %10lu - %10lu = %10lu\n", i, x, carry, y, res);
+// ---- limb level helpers ----
+// these operate on raw little endian arrays of base 2^32 limbs and are private to the library
 
-        if (BIGINT_GUARD(dst) != 0) {
-            bigint_increment_size(dst);
-        }
+static uint32_t bigint_limb_bitlen(uint32_t x) {
+#if defined(__GNUC__)
+    return x == 0 ? 0 : 32 - __builtin_clz(x);
+#else
+    uint32_t n = 0;
+    while (x) {
+        n++;
+        x >>= 1;
     }
+    return n;
+#endif
 }
 
-void naive_mult(BigInt *dest, uint32_t multiplier) {
+static uint32_t bigint_limb_ctz(uint32_t x) {
+#if defined(__GNUC__)
+    return x == 0 ? 32 : __builtin_ctz(x);
+#else
+    uint32_t n = 0;
+    if (x == 0) return 32;
+    while ((x & 1) == 0) {
+        n++;
+        x >>= 1;
+    }
+    return n;
+#endif
+}
 
-    // store product of least significant digit and multiplier in 64 bit variable
-    uint32_t carry = 0;
-    size_t i;
-    for (i = 0; i < dest->size; i++) {
-        uint64_t product = (uint64_t)dest->buf[i] * multiplier + carry;
-        // store lower 32 bits at 0 th place
-        dest->buf[i] = (uint32_t)(product & 0xFFFFFFFF);
-        // store higher 32 bits in carry for next iteration
-        carry = (uint32_t)(product >> 32);
-        if (BIGINT_GUARD(dest) != 0) {
-            bigint_increment_size(dest);
-        }
+// returns length of `a` with leading zero limbs stripped
+static size_t bigint_limbs_normalize(const uint32_t *a, size_t n) {
+    while (n > 0 && a[n - 1] == 0) {
+        n--;
     }
+    return n;
+}
 
-    // If there is still a carry, add new digit
-    dest->buf[i] = carry;
-    if (BIGINT_GUARD(dest) != 0) {
-        bigint_increment_size(dest);
+// number of significant limbs in a BigInt, 0 for zero (the guard limb is not counted)
+static size_t bigint_used(const BigInt *num) {
+    return num->size > 1 ? bigint_limbs_normalize(num->buf, num->size - 1) : 0;
+}
+
+// makes sure `limbs` value limbs plus the guard limb fit without further growth,
+// also detaches a shared buffer since every caller is about to write to it.
+// a buffer that has to grow anyway grows by at least the growth policy so values
+// creeping up a limb at a time do not realloc every time
+static void bigint_reserve_limbs(BigInt *num, size_t limbs) {
+    size_t need = limbs + 2;
+    bigint_make_unique(num);
+    if (num->capacity >= need) return;
+
+    size_t grown = bigint_grown_capacity(num->capacity);
+    size_t new_cap = grown > need && num->size > 2 ? grown : need;
+    num->buf = bigint_buf_realloc(num->buf, num->capacity, new_cap);
+    num->capacity = new_cap;
+}
+
+// presizes num to hold n_bits without reallocating
+void bigint_reserve(BigInt *num, uint64_t n_bits) {
+    size_t limbs = (size_t)((n_bits + BASE - 1) / BASE);
+    size_t need = limbs + 2;
+    bigint_make_unique(num);
+    if (num->capacity >= need) return;
+
+    num->buf = bigint_buf_realloc(num->buf, num->capacity, need);
+    num->capacity = need;
+}
+
+// gives back the capacity beyond the current size (plus the one spare limb size < capacity needs)
+void bigint_shrink_to_fit(BigInt *num) {
+    // a fresh value has size 1 but becomes 2 as soon as it is set, keep a spare limb above that
+    size_t fit = (num->size > 2 ? num->size : 2) + 1;
+    if (num->capacity <= fit) return;
+
+    if (bigint_is_shared(num)) {
+        uint32_t *buf = bigint_buf_alloc(fit);
+        memcpy(buf, num->buf, num->size * sizeof(uint32_t));
+        bigint_buf_release(num->buf);
+        num->buf = buf;
+    } else {
+        num->buf = bigint_buf_realloc(num->buf, num->capacity, fit);
     }
+    num->capacity = fit;
 }
 
-void naive_divide(BigInt *dividend, uint32_t divisor, BigInt *quo, uint32_t *rem) {
-    *rem = 0;
-    bigint_set(quo, "0");
-
-    // iterate over all the bits on BigInt from MSB to LSB
-    for (int i = dividend->size - 2; i >= 0; i--) {
-        for (int j = 0; j < BASE; j++) {
-            // extract a single bit
-            uint32_t curr_bit = dividend->buf[i] & (1 << (BASE - j - 1));
-            curr_bit = (curr_bit > 0 ? 1 : 0);
-
-            // perform division
-            *rem = *rem << 1;
-            *rem += curr_bit;
-            bigint_left_shift(quo, 1);
-            if (*rem >= divisor) {
-                *rem -= divisor;
-                naive_add(quo, 1);
-            }
-        }
+// sets size from the number of value limbs written to buf and zeroes everything above them
+static void bigint_set_used(BigInt *num, size_t used) {
+    size_t new_size = (used ? used : 1) + 1;
+    size_t end = (num->size > new_size ? num->size : new_size);
+    memset(num->buf + used, 0, (end - used) * sizeof(uint32_t));
+    num->size = new_size;
+}
 
-        if (BIGINT_GUARD(quo) != 0) {
-            bigint_increment_size(quo);
+// schoolbook r = a * b, r must have room for an + bn limbs and must not overlap a or b.
+// returns false if ctx cancelled it part way
+static bool bigint_limbs_mul_basecase(uint32_t *r, const uint32_t *a, size_t an, const uint32_t *b, size_t bn, BigIntCtx *ctx) {
+    size_t rows_per_poll = BIGINT_CTX_POLL_WORK / bn + 1;
+    memset(r, 0, (an + bn) * sizeof(uint32_t));
+    for (size_t i = 0; i < an; i++) {
+        if (ctx && i % rows_per_poll == rows_per_poll - 1 && bigint_ctx_poll(ctx, i, an)) return false;
+        uint64_t ai = a[i];
+        uint64_t carry = 0;
+        if (ai == 0) continue;
+        for (size_t j = 0; j < bn; j++) {
+            uint64_t t = ai * b[j] + r[i + j] + carry;
+            r[i + j] = (uint32_t)t;
+            carry = t >> 32;
         }
+        r[i + bn] = (uint32_t)carry;
     }
+    return true;
 }
 
-void bigint_left_shift(BigInt *bigint, uint32_t shift_by) {
-    assert(shift_by < 32 && "Cannot shift more than 31 bits at a time");
-    // this function iterates from MSB to LSB with a 32 bit window
-    // each iteration current window is shifted by `shift_by`
-    // and the bits that will get discarded in the next iteration are stored in discarded
-    // then the discarded bits from next window is added to current window
-
-    if(shift_by == 0) {
-        return;
+// schoolbook r = a * a, computes each cross product once and doubles it.
+// returns false if ctx cancelled it part way
+static bool bigint_limbs_sqr_basecase(uint32_t *r, const uint32_t *a, size_t n, BigIntCtx *ctx) {
+    size_t rows_per_poll = BIGINT_CTX_POLL_WORK / n + 1;
+    memset(r, 0, 2 * n * sizeof(uint32_t));
+    for (size_t i = 0; i < n; i++) {
+        if (ctx && i % rows_per_poll == rows_per_poll - 1 && bigint_ctx_poll(ctx, i, n)) return false;
+        uint64_t ai = a[i];
+        uint64_t carry = 0;
+        for (size_t j = i + 1; j < n; j++) {
+            uint64_t t = ai * a[j] + r[i + j] + carry;
+            r[i + j] = (uint32_t)t;
+            carry = t >> 32;
+        }
+        r[i + n] = (uint32_t)carry;
     }
-    
-    for (int i = bigint->size - 1; i > 0; i--) {
-        bigint->buf[i] <<= shift_by;
-        uint32_t discarded = (bigint->buf[i - 1] >> (BASE - shift_by)) & ((1U << shift_by) - 1);
-        bigint->buf[i] |= discarded;
+
+    uint32_t high_bit = 0;
+    for (size_t i = 0; i < 2 * n; i++) {
+        uint32_t v = r[i];
+        r[i] = (v << 1) | high_bit;
+        high_bit = v >> 31;
     }
-    
-    // handle overflow that may happend after left shift 
-    if(BIGINT_GUARD(bigint) != 0){
-        bigint_increment_size(bigint);
+
+    uint64_t carry = 0;
+    for (size_t i = 0; i < n; i++) {
+        uint64_t sq = (uint64_t)a[i] * a[i];
+        uint64_t t = (uint64_t)r[2 * i] + (uint32_t)sq + carry;
+        r[2 * i] = (uint32_t)t;
+        t = (uint64_t)r[2 * i + 1] + (sq >> 32) + (t >> 32);
+        r[2 * i + 1] = (uint32_t)t;
+        carry = t >> 32;
     }
-    bigint->buf[0] <<= shift_by;
+    return true;
 }
 
-void bigint_right_shift(BigInt *bigint, uint32_t shift_by) {
-    assert(shift_by < 32 && "Cannot shift more than 31 bits at a time");
-    // this function iterates from LSB to MSB with a 32 bit window
-    // each iteration current window is right shifted by `shift_by`
-    // and the bits that will get discarded in the next iteration are stored in discarded
-    // then the discarded bits from next window is added to current window
+// r = a << bits for 0 < bits < 32, returns the bits shifted out, r may equal a
+static uint32_t bigint_limbs_lshift(uint32_t *r, const uint32_t *a, size_t n, uint32_t bits) {
+    uint32_t out = 0;
+    for (size_t i = n; i > 0; i--) {
+        uint32_t v = a[i - 1];
+        if (i == n) out = v >> (BASE - bits);
+        r[i - 1] = (v << bits) | (i > 1 ? a[i - 2] >> (BASE - bits) : 0);
+    }
+    return out;
+}
 
-    if (shift_by == 0) {
-        return;
+// r = a >> bits for 0 < bits < 32, r may equal a
+static void bigint_limbs_rshift(uint32_t *r, const uint32_t *a, size_t n, uint32_t bits) {
+    for (size_t i = 0; i < n; i++) {
+        r[i] = (a[i] >> bits) | (i + 1 < n ? a[i + 1] << (BASE - bits) : 0);
     }
+}
 
-    for (size_t i = 0; i < bigint->size - 1; i++) {
-        bigint->buf[i] >>= shift_by;
-        uint32_t discarded = bigint->buf[i + 1] & ((1 << shift_by) - 1U);
-        bigint->buf[i] |= discarded << (BASE - shift_by);
+// compares two normalized limb arrays, returns -1, 0 or 1
+static int bigint_limbs_cmp(const uint32_t *a, size_t an, const uint32_t *b, size_t bn) {
+    if (an != bn) return an > bn ? 1 : -1;
+    for (size_t i = an; i > 0; i--) {
+        if (a[i - 1] != b[i - 1]) return a[i - 1] > b[i - 1] ? 1 : -1;
     }
+    return 0;
+}
 
-    // handle size reduction
-    if (bigint->size > 2 && bigint->buf[bigint->size - 2] == 0) {
-        bigint->size--;
+// r = a + b for an >= bn, returns the carry out, r may alias a or b
+static uint32_t bigint_limbs_add(uint32_t *r, const uint32_t *a, size_t an, const uint32_t *b, size_t bn) {
+    uint64_t carry = 0;
+    size_t i = 0;
+    for (; i < bn; i++) {
+        carry += (uint64_t)a[i] + b[i];
+        r[i] = (uint32_t)carry;
+        carry >>= 32;
+    }
+    for (; i < an; i++) {
+        carry += a[i];
+        r[i] = (uint32_t)carry;
+        carry >>= 32;
     }
+    return (uint32_t)carry;
 }
 
-void bigint_to_dec_str(BigInt bigint, char *str_buf, size_t str_buf_size) {
-    // divide the bigint successivly by 10 and push the remainder to a string buffer
-    uint32_t rem = 0;
+// r = a - b for a >= b (so an >= bn), r may alias a or b
+static void bigint_limbs_sub(uint32_t *r, const uint32_t *a, size_t an, const uint32_t *b, size_t bn) {
+    uint64_t borrow = 0;
     size_t i = 0;
-    BigInt dividend = bigint;
-    BigInt quo = bigint_alloc();
-    bool is_negative = bigint.is_negative;
-    
-    do {
-        assert(i < str_buf_size && "buffer overflow");
-        naive_divide(&dividend, 10, &quo, &rem);
-        str_buf[i++] = rem + '0';
-        bigint_deep_copy(&dividend, &quo);
-    } while (!bigint_isequal_uint32(dividend, 0));
+    for (; i < bn; i++) {
+        uint64_t diff = (uint64_t)a[i] - b[i] - borrow;
+        r[i] = (uint32_t)diff;
+        borrow = (diff >> 32) & 1;
+    }
+    for (; i < an; i++) {
+        uint64_t diff = (uint64_t)a[i] - borrow;
+        r[i] = (uint32_t)diff;
+        borrow = (diff >> 32) & 1;
+    }
+}
 
-    bigint_free(&quo);
+// ---- Karatsuba multiplication ----
+// (a0 + a1 B^m)(b0 + b1 B^m) = z0 + (z1 - z0 - z2) B^m + z2 B^2m with z0 = a0 b0, z2 = a1 b1 and
+// z1 = (a0 + a1)(b0 + b1), three half size products instead of four. operands below the
+// thresholds, and so the leaves of the recursion, go to the schoolbook kernels.
 
-    if(is_negative) {
-        str_buf[i] = '-';
-        ++i;
-    }
-    
-    // reverse string buffer
-    size_t left = 0, right = --i;
-    while (left < right) {
-        char temp = str_buf[left];
-        str_buf[left] = str_buf[right];
-        str_buf[right] = temp;
-        left++;
-        right--;
+typedef struct {
+    BigIntCtx *ctx;
+    uint64_t done;        // limb products finished by the schoolbook leaves
+    uint64_t total;       // limb products of all leaves, only counted when there is a ctx
+    uint64_t polled;      // done at the last poll
+    size_t mul_threshold; // snapshot of the thresholds for the whole product
+    size_t sqr_threshold;
+} BigIntKaratsuba;
+
+// at least 4 limbs so both halves are nonempty and every split shrinks the operands
+static size_t bigint_karatsuba_threshold(BigIntThreshold which) {
+    size_t limbs = bigint_get_threshold(which);
+    return limbs < 4 ? 4 : limbs;
+}
+
+// limb products done by the schoolbook leaves of bigint_karatsuba, follows its recursion exactly
+static uint64_t bigint_karatsuba_work(const BigIntKaratsuba *k, size_t an, size_t bn, bool square) {
+    if (bn < (square ? k->sqr_threshold : k->mul_threshold)) return (uint64_t)an * bn;
+    size_t m = (an + 1) / 2;
+    if (bn <= m) {
+        uint64_t work = 0;
+        for (size_t i = 0; i < an; i += bn) {
+            work += bigint_karatsuba_work(k, bn, an - i < bn ? an - i : bn, false);
+        }
+        return work;
     }
+    return bigint_karatsuba_work(k, m, m, square) + bigint_karatsuba_work(k, an - m, bn - m, square) +
+           bigint_karatsuba_work(k, m + 1, m + 1, square);
 }
 
-bool bigint_isequal_uint32(BigInt a, uint32_t b) {
-    if (a.buf[0] != b) {
-        return false;
+// scratch limbs bigint_karatsuba needs for a product whose larger operand has n limbs
+static size_t bigint_karatsuba_scratch(size_t n) {
+    size_t limbs = 0;
+    for (; n >= 4; n = (n + 1) / 2 + 1) limbs += 4 * ((n + 1) / 2) + 4;
+    return limbs;
+}
+
+// r = a * b for an >= bn, or a * a when square (b == a). r must not overlap a, b or scratch.
+// returns false if the ctx of k cancelled it
+static bool bigint_karatsuba(BigIntKaratsuba *k, uint32_t *r, const uint32_t *a, size_t an, const uint32_t *b,
+                             size_t bn, bool square, uint32_t *scratch) {
+    if (bn < (square ? k->sqr_threshold : k->mul_threshold)) {
+        if (square) {
+            bigint_limbs_sqr_basecase(r, a, an, NULL);
+        } else {
+            bigint_limbs_mul_basecase(r, a, an, b, bn, NULL);
+        }
+        k->done += (uint64_t)an * bn;
+        if (k->ctx == NULL || k->done - k->polled < BIGINT_CTX_POLL_WORK) return true;
+        k->polled = k->done;
+        return !bigint_ctx_poll(k->ctx, k->done, k->total);
     }
-    for (size_t i = 1; i < a.size; i++) {
-        if (a.buf[i] != 0) {
-            return false;
+
+    size_t m = (an + 1) / 2;
+    if (bn <= m) {
+        // too unbalanced to split both operands, multiply b by bn limb slices of a
+        uint32_t *t = scratch;
+        memset(r, 0, (an + bn) * sizeof(uint32_t));
+        for (size_t i = 0; i < an; i += bn) {
+            size_t c = an - i < bn ? an - i : bn;
+            if (!bigint_karatsuba(k, t, b, bn, a + i, c, false, scratch + 2 * bn)) return false;
+            bigint_limbs_add(r + i, r + i, an + bn - i, t, bn + c);
         }
+        return true;
     }
+
+    uint32_t *sa = scratch;
+    uint32_t *sb = scratch + m + 1;
+    uint32_t *z1 = scratch + 2 * m + 2;
+    uint32_t *child = scratch + 4 * m + 4;
+    if (!bigint_karatsuba(k, r, a, m, b, m, square, child)) return false;
+    if (!bigint_karatsuba(k, r + 2 * m, a + m, an - m, b + m, bn - m, square, child)) return false;
+    sa[m] = bigint_limbs_add(sa, a, m, a + m, an - m);
+    if (!square) sb[m] = bigint_limbs_add(sb, b, m, b + m, bn - m);
+    if (!bigint_karatsuba(k, z1, sa, m + 1, square ? sa : sb, m + 1, square, child)) return false;
+
+    // z1 - z0 - z2 = a0 b1 + a1 b0 fits in the an + bn - m limbs from r + m on
+    bigint_limbs_sub(z1, z1, 2 * m + 2, r, 2 * m);
+    bigint_limbs_sub(z1, z1, 2 * m + 2, r + 2 * m, an + bn - 2 * m);
+    bigint_limbs_add(r + m, r + m, an + bn - m, z1, bigint_limbs_normalize(z1, 2 * m + 2));
     return true;
 }
 
-void bigint_shallow_copy(BigInt *dst, BigInt *src) {
-    dst->size = src->size;
-    dst->capacity = src->capacity;
-    dst->buf = src->buf;
+// runs bigint_karatsuba with its scratch, progress goes to ctx in limb products of the leaves
+static bool bigint_karatsuba_run(uint32_t *r, const uint32_t *a, size_t an, const uint32_t *b, size_t bn,
+                                 bool square, BigIntCtx *ctx) {
+    BigIntKaratsuba k = {ctx, 0, 0, 0, bigint_karatsuba_threshold(BIGINT_THRESHOLD_KARATSUBA_MUL),
+                         bigint_karatsuba_threshold(BIGINT_THRESHOLD_KARATSUBA_SQR)};
+    if (ctx) k.total = bigint_karatsuba_work(&k, an, bn, square);
+    uint32_t *scratch = (uint32_t *)malloc(bigint_karatsuba_scratch(an) * sizeof(uint32_t));
+    assert(scratch != NULL && "memory allocation failed");
+    bool done = bigint_karatsuba(&k, r, a, an, b, bn, square, scratch);
+    free(scratch);
+    return done;
 }
-void bigint_deep_copy(BigInt *dst, BigInt *src) {
-    dst->size = src->size;
-    dst->capacity = src->capacity;
-    memcpy(dst->buf, src->buf, sizeof(src->buf[0]) * src->size);
+
+// r = a * b, r must have room for an + bn limbs and must not overlap a or b.
+// returns false if ctx cancelled it part way
+static bool bigint_limbs_mul(uint32_t *r, const uint32_t *a, size_t an, const uint32_t *b, size_t bn, BigIntCtx *ctx) {
+    if (an < bn) {
+        const uint32_t *t = a;
+        a = b;
+        b = t;
+        size_t tn = an;
+        an = bn;
+        bn = tn;
+    }
+    if (bn < bigint_karatsuba_threshold(BIGINT_THRESHOLD_KARATSUBA_MUL)) {
+        return bigint_limbs_mul_basecase(r, a, an, b, bn, ctx);
+    }
+    return bigint_karatsuba_run(r, a, an, b, bn, false, ctx);
+}
+
+// r = a * a, r must have room for 2n limbs and must not overlap a.
+// returns false if ctx cancelled it part way
+static bool bigint_limbs_sqr(uint32_t *r, const uint32_t *a, size_t n, BigIntCtx *ctx) {
+    if (n < bigint_karatsuba_threshold(BIGINT_THRESHOLD_KARATSUBA_SQR)) return bigint_limbs_sqr_basecase(r, a, n, ctx);
+    return bigint_karatsuba_run(r, a, n, a, n, true, ctx);
+}
+
+// Möller-Granlund reciprocal floor((B^2 - 1) / d) - B of a normalized limb (top bit set)
+static uint32_t bigint_limb_reciprocal(uint32_t d) {
+    return (uint32_t)(UINT64_MAX / d - (1ULL << 32));
+}
+
+// divides u1:u0 by the normalized limb d using inv = bigint_limb_reciprocal(d), needs u1 < d.
+// one multiply and two cheap corrections instead of a hardware divide.
+// returns the quotient limb and stores the remainder in *r
+static inline uint32_t bigint_limb_div_pre(uint32_t u1, uint32_t u0, uint32_t d, uint32_t inv, uint32_t *r) {
+    uint64_t qq = (uint64_t)inv * u1 + (((uint64_t)u1 << 32) | u0);
+    uint32_t q = (uint32_t)(qq >> 32) + 1;
+    uint32_t rem = u0 - q * d;
+    if (rem > (uint32_t)qq) {
+        q--;
+        rem += d;
+    }
+    if (rem >= d) {
+        q++;
+        rem -= d;
+    }
+    *r = rem;
+    return q;
+}
+
+// q = a / d where dn = d << shift is normalized and inv its reciprocal, returns a % d.
+// q may alias a or be NULL when only the remainder is wanted
+static uint32_t bigint_limbs_divmod_1_pre(uint32_t *q, const uint32_t *a, size_t n, uint32_t dn, uint32_t shift,
+                                          uint32_t inv) {
+    uint32_t r = 0, qi;
+    if (n == 0) return 0;
+    if (shift == 0) {
+        for (size_t i = n; i > 0; i--) {
+            qi = bigint_limb_div_pre(r, a[i - 1], dn, inv, &r);
+            if (q) q[i - 1] = qi;
+        }
+        return r;
+    }
+
+    // feed the dividend shifted by the same amount as the divisor, the quotient is unchanged
+    r = a[n - 1] >> (BASE - shift);
+    for (size_t i = n; i > 0; i--) {
+        uint32_t u0 = (a[i - 1] << shift) | (i > 1 ? a[i - 2] >> (BASE - shift) : 0);
+        qi = bigint_limb_div_pre(r, u0, dn, inv, &r);
+        if (q) q[i - 1] = qi;
+    }
+    return r >> shift;
+}
+
+// q = a / d, returns a % d, q may alias a
+static uint32_t bigint_limbs_divmod_1(uint32_t *q, const uint32_t *a, size_t n, uint32_t d) {
+    uint32_t shift = BASE - bigint_limb_bitlen(d);
+    uint32_t dn = d << shift;
+    return bigint_limbs_divmod_1_pre(q, a, n, dn, shift, bigint_limb_reciprocal(dn));
+}
+
+// schoolbook long division (Knuth algorithm D) by an already normalized divisor vn (n >= 2 limbs,
+// top bit set) whose top limb has reciprocal inv. un holds the dividend shifted by the same amount
+// in m limbs plus the limb shifted out at un[m], and is left holding the shifted remainder in its
+// low n limbs. q gets m - n + 1 limbs and may be NULL.
+// returns false if ctx cancelled it part way
+static bool bigint_limbs_divmod_norm(uint32_t *q, uint32_t *un, size_t m, const uint32_t *vn, size_t n, uint32_t inv,
+                                     BigIntCtx *ctx) {
+    size_t steps_per_poll = BIGINT_CTX_POLL_WORK / n + 1;
+    for (size_t j = m - n + 1; j-- > 0;) {
+        size_t done = m - n - j;
+        if (ctx && done % steps_per_poll == steps_per_poll - 1 && bigint_ctx_poll(ctx, done, m - n + 1)) {
+            return false;
+        }
+        // the normalized divisor keeps the quotient estimate off by at most 2
+        uint64_t qhat, rhat;
+        if (un[j + n] >= vn[n - 1]) {
+            qhat = 0xFFFFFFFFULL;
+            rhat = (uint64_t)un[j + n - 1] + vn[n - 1];
+        } else {
+            uint32_t r32;
+            qhat = bigint_limb_div_pre(un[j + n], un[j + n - 1], vn[n - 1], inv, &r32);
+            rhat = r32;
+        }
+        while (rhat <= 0xFFFFFFFFULL && qhat * vn[n - 2] > ((rhat << 32) | un[j + n - 2])) {
+            qhat--;
+            rhat += vn[n - 1];
+        }
+
+        // un[j .. j + n] -= qhat * vn
+        uint64_t carry = 0, borrow = 0;
+        for (size_t i = 0; i < n; i++) {
+            uint64_t p = qhat * vn[i] + carry;
+            carry = p >> 32;
+            uint64_t diff = (uint64_t)un[i + j] - (uint32_t)p - borrow;
+            un[i + j] = (uint32_t)diff;
+            borrow = (diff >> 32) & 1;
+        }
+        uint64_t diff = (uint64_t)un[j + n] - carry - borrow;
+        un[j + n] = (uint32_t)diff;
+
+        // estimate was one too large, add the divisor back
+        if ((diff >> 32) & 1) {
+            qhat--;
+            carry = 0;
+            for (size_t i = 0; i < n; i++) {
+                carry += (uint64_t)un[i + j] + vn[i];
+                un[i + j] = (uint32_t)carry;
+                carry >>= 32;
+            }
+            un[j + n] += (uint32_t)carry;
+        }
+        if (q) q[j] = (uint32_t)qhat;
+    }
+    return true;
+}
+
+// u (m limbs) shifted left by shift < 32 into un, which needs m + 1 limbs
+static void bigint_limbs_normalize_dividend(uint32_t *un, const uint32_t *u, size_t m, uint32_t shift) {
+    if (shift) {
+        un[m] = bigint_limbs_lshift(un, u, m, shift);
+    } else {
+        memcpy(un, u, m * sizeof(uint32_t));
+        un[m] = 0;
+    }
+}
+
+// r = un >> shift for the n limb remainder left behind by a normalized division, r may equal un
+static void bigint_limbs_denormalize_rem(uint32_t *r, const uint32_t *un, size_t n, uint32_t shift) {
+    if (shift) {
+        bigint_limbs_rshift(r, un, n, shift);
+        r[n - 1] |= un[n] << (BASE - shift);
+    } else {
+        memcpy(r, un, n * sizeof(uint32_t));
+    }
+}
+
+// schoolbook long division (Knuth algorithm D) of u (m limbs) by v (n >= 2 limbs, v[n - 1] != 0),
+// q gets m - n + 1 limbs and r gets n limbs, either may be NULL.
+// returns false if ctx cancelled it part way
+static bool bigint_limbs_divmod(uint32_t *q, uint32_t *r, const uint32_t *u, size_t m, const uint32_t *v, size_t n,
+                                BigIntCtx *ctx) {
+    uint32_t shift = BASE - bigint_limb_bitlen(v[n - 1]);
+    uint32_t *vn = (uint32_t *)malloc(n * sizeof(uint32_t));
+    uint32_t *un = (uint32_t *)malloc((m + 1) * sizeof(uint32_t));
+    assert(vn != NULL && un != NULL && "memory allocation failed");
+
+    if (shift) {
+        bigint_limbs_lshift(vn, v, n, shift);
+    } else {
+        memcpy(vn, v, n * sizeof(uint32_t));
+    }
+    bigint_limbs_normalize_dividend(un, u, m, shift);
+
+    bool done = bigint_limbs_divmod_norm(q, un, m, vn, n, bigint_limb_reciprocal(vn[n - 1]), ctx);
+    if (done && r) bigint_limbs_denormalize_rem(r, un, n, shift);
+    free(vn);
+    free(un);
+    return done;
+}
+
+// dst = a + b, or a - b when negate_b is set, with full sign-magnitude handling.
+// dst may alias a or b.
+static void bigint_add_signed(BigInt *dst, BigInt *a, BigInt *b, bool negate_b) {
+    size_t an = bigint_used(a);
+    size_t bn = bigint_used(b);
+    bool a_neg = a->is_negative;
+    bool b_neg = b->is_negative != negate_b;
+#ifdef BIGINT_DEBUG
+    printf("%s\n", negate_b ? "bigint_sub" : "bigint_add");
+    bigint_mem_dump(*a);
+    bigint_mem_dump(*b);
+#endif
+
+    // make `a` the operand with the larger magnitude
+    int cmp = bigint_limbs_cmp(a->buf, an, b->buf, bn);
+    if (cmp < 0) {
+        BigInt *t = a; a = b; b = t;
+        size_t tn = an; an = bn; bn = tn;
+        bool tneg = a_neg; a_neg = b_neg; b_neg = tneg;
+    }
+
+    bigint_reserve_limbs(dst, an + 1);
+    size_t used;
+    if (a_neg == b_neg) {
+        dst->buf[an] = bigint_limbs_add(dst->buf, a->buf, an, b->buf, bn);
+        used = bigint_limbs_normalize(dst->buf, an + 1);
+    } else if (cmp == 0) {
+        used = 0;
+    } else {
+        bigint_limbs_sub(dst->buf, a->buf, an, b->buf, bn);
+        used = bigint_limbs_normalize(dst->buf, an);
+    }
+    bigint_set_used(dst, used);
+    dst->is_negative = used != 0 && a_neg;
+#ifdef BIGINT_DEBUG
+    bigint_mem_dump(*dst);
+#endif
+}
+
+void bigint_add(BigInt *dst, BigInt *a, BigInt *b) {
+    bigint_add_signed(dst, a, b, false);
+}
+
+void naive_add(BigInt *dest, uint32_t operand) {
+    bigint_make_unique(dest);
+    if (dest->is_negative) {
+        // -|dest| + operand flips the sign once the operand reaches the magnitude
+        if (bigint_used(dest) <= 1 && dest->buf[0] <= operand) {
+            dest->buf[0] = operand - dest->buf[0];
+            dest->is_negative = 0;
+            return;
+        }
+        // otherwise the operand is taken off the magnitude, the borrow stops below the top limb
+        uint32_t low = dest->buf[0];
+        dest->buf[0] = low - operand;
+        if (low < operand) {
+            for (size_t i = 1; dest->buf[i]-- == 0; i++) {
+            }
+        }
+        return;
+    }
+
+    // store addition of least significant digit and operand in 64 bit variable
+    uint64_t sum = (uint64_t)dest->buf[0] + operand;
+    // store lower 32 bits at 0 th place
+    dest->buf[0] = (uint32_t)(sum & 0xFFFFFFFF);
+    // store higher 32 bits in carry for next iteration
+    uint32_t carry = (uint32_t)(sum >> 32);
+
+    // propogate carry
+    size_t i = 0;
+    while (carry != 0) {
+        i++;
+        // add carry to next digit
+        uint64_t temp = (uint64_t)dest->buf[i] + carry;
+        // store lower 32 bits at i th place
+        dest->buf[i] = (uint32_t)(temp & 0xFFFFFFFF);
+        // update carry
+        carry = (uint32_t)(temp >> 32);
+
+        if (BIGINT_GUARD(dest) != 0) {
+            bigint_increment_size(dest);
+        }
+    }
+}
+
+void bigint_sub(BigInt *dst, BigInt *a, BigInt *b) {
+    bigint_add_signed(dst, a, b, true);
+}
+
+void naive_mult(BigInt *dest, uint32_t multiplier) {
+    bigint_make_unique(dest);
+
+    // store product of least significant digit and multiplier in 64 bit variable
+    uint32_t carry = 0;
+    size_t i;
+    for (i = 0; i < dest->size; i++) {
+        uint64_t product = (uint64_t)dest->buf[i] * multiplier + carry;
+        // store lower 32 bits at 0 th place
+        dest->buf[i] = (uint32_t)(product & 0xFFFFFFFF);
+        // store higher 32 bits in carry for next iteration
+        carry = (uint32_t)(product >> 32);
+        if (BIGINT_GUARD(dest) != 0) {
+            bigint_increment_size(dest);
+        }
+    }
+
+    // If there is still a carry, add new digit
+    dest->buf[i] = carry;
+    if (BIGINT_GUARD(dest) != 0) {
+        bigint_increment_size(dest);
+    }
+}
+
+void naive_divide(BigInt *dividend, uint32_t divisor, BigInt *quo, uint32_t *rem) {
+    assert(divisor != 0 && "division by zero");
+    size_t n = bigint_used(dividend);
+
+    // one limb at a time through the reciprocal of the divisor, quo may alias dividend
+    if (quo != dividend) bigint_reserve_limbs(quo, n);
+    else bigint_make_unique(quo);
+    *rem = bigint_limbs_divmod_1(quo->buf, dividend->buf, n, divisor);
+    bigint_set_used(quo, bigint_limbs_normalize(quo->buf, n));
+    quo->is_negative = 0;
+}
+
+// truncating division like C: quo is rounded toward zero and rem takes the sign of a.
+// quo or rem may be NULL, either may alias a or b
+BigIntStatus bigint_divmod_ctx(BigInt *quo, BigInt *rem, BigInt *a, BigInt *b, BigIntCtx *ctx) {
+    size_t an = bigint_used(a);
+    size_t bn = bigint_used(b);
+    assert(bn != 0 && "division by zero");
+    bool q_neg = a->is_negative != b->is_negative;
+    bool r_neg = a->is_negative;
+
+    if (an < bn || bigint_limbs_cmp(a->buf, an, b->buf, bn) < 0) {
+        if (rem) bigint_deep_copy(rem, a);
+        if (quo) bigint_set_zero(quo);
+        return BIGINT_OK;
+    }
+
+    uint32_t *q = (uint32_t *)calloc(an - bn + 1, sizeof(uint32_t));
+    uint32_t *r = (uint32_t *)calloc(bn, sizeof(uint32_t));
+    assert(q != NULL && r != NULL && "memory allocation failed");
+    bool done = true;
+    if (bn == 1) {
+        r[0] = bigint_limbs_divmod_1(q, a->buf, an, b->buf[0]);
+    } else {
+        done = bigint_limbs_divmod(q, r, a->buf, an, b->buf, bn, ctx);
+    }
+
+    if (quo) {
+        bigint_from_limbs(quo, q, done ? an - bn + 1 : 0);
+        quo->is_negative = q_neg && bigint_used(quo) != 0;
+    }
+    if (rem) {
+        bigint_from_limbs(rem, r, done ? bn : 0);
+        rem->is_negative = r_neg && bigint_used(rem) != 0;
+    }
+    free(q);
+    free(r);
+    return done ? BIGINT_OK : BIGINT_CANCELLED;
+}
+
+void bigint_divmod(BigInt *quo, BigInt *rem, BigInt *a, BigInt *b) {
+    bigint_divmod_ctx(quo, rem, a, b, NULL);
+}
+
+// ---- division by invariant divisors ----
+
+void bigint_divisor_init(BigIntDivisor *div, BigInt *d) {
+    size_t n = bigint_used(d);
+    assert(n != 0 && "division by zero");
+    div->n = n;
+    div->is_negative = d->is_negative;
+    div->shift = BASE - bigint_limb_bitlen(d->buf[n - 1]);
+    div->limbs = (uint32_t *)malloc(n * sizeof(uint32_t));
+    assert(div->limbs != NULL && "memory allocation failed");
+    if (div->shift) {
+        bigint_limbs_lshift(div->limbs, d->buf, n, div->shift);
+    } else {
+        memcpy(div->limbs, d->buf, n * sizeof(uint32_t));
+    }
+    div->inv = bigint_limb_reciprocal(div->limbs[n - 1]);
+
+    div->mu = NULL;
+    if (n >= 2 && n >= bigint_get_threshold(BIGINT_THRESHOLD_BARRETT)) {
+        // mu = B^2n / limbs, one Knuth division whose quotient has a zero top limb
+        uint32_t *u = (uint32_t *)calloc(2 * n + 2, sizeof(uint32_t));
+        div->mu = (uint32_t *)calloc(n + 2, sizeof(uint32_t));
+        assert(u != NULL && div->mu != NULL && "memory allocation failed");
+        u[2 * n] = 1;
+        bigint_limbs_divmod_norm(div->mu, u, 2 * n + 1, div->limbs, n, div->inv, NULL);
+        free(u);
+    }
+}
+
+void bigint_divisor_free(BigIntDivisor *div) {
+    free(div->limbs);
+    free(div->mu);
+    div->limbs = NULL;
+    div->mu = NULL;
+    div->n = 0;
+}
+
+// Barrett division of the normalized dividend un (m + 1 limbs) by div->limbs, leaves the
+// normalized remainder in un[0 .. n - 1]. works through the dividend n limbs at a time, each
+// step estimates n quotient limbs from the top n + 1 limbs of a 2n limb window times mu,
+// which is at most 2 too small. q gets m - n + 1 limbs and may be NULL
+static void bigint_limbs_divmod_barrett(uint32_t *q, uint32_t *un, size_t m, const BigIntDivisor *div) {
+    size_t n = div->n;
+    const uint32_t *vn = div->limbs;
+    // pad the dividend to whole blocks plus a zero block on top, the running remainder
+    size_t blocks = (m + 1 + n - 1) / n;
+    uint32_t *w = (uint32_t *)calloc((blocks + 1) * n, sizeof(uint32_t));
+    uint32_t *qw = (uint32_t *)calloc(blocks * n, sizeof(uint32_t));
+    uint32_t *t = (uint32_t *)malloc((2 * n + 2) * sizeof(uint32_t));
+    uint32_t *p = (uint32_t *)malloc(2 * n * sizeof(uint32_t));
+    assert(w != NULL && qw != NULL && t != NULL && p != NULL && "memory allocation failed");
+    memcpy(w, un, (m + 1) * sizeof(uint32_t));
+
+    for (size_t j = blocks; j-- > 0;) {
+        uint32_t *x = w + j * n;
+        // q3 = ((x >> (n - 1) limbs) * mu) >> (n + 1) limbs, fits in n limbs
+        bigint_limbs_mul(t, x + n - 1, n + 1, div->mu, n + 1, NULL);
+        uint32_t *q3 = t + n + 1;
+
+        // the remainder x - q3 * vn is below 3 vn so its low n + 1 limbs are enough
+        bigint_limbs_mul(p, q3, n, vn, n, NULL);
+        bigint_limbs_sub(x, x, n + 1, p, n + 1);
+        while (bigint_limbs_cmp(x, bigint_limbs_normalize(x, n + 1), vn, n) >= 0) {
+            bigint_limbs_sub(x, x, n + 1, vn, n);
+            for (size_t i = 0; i < n && ++q3[i] == 0; i++) {
+            }
+        }
+        memcpy(qw + j * n, q3, n * sizeof(uint32_t));
+        memset(x + n, 0, n * sizeof(uint32_t));
+    }
+
+    memcpy(un, w, (n + 1) * sizeof(uint32_t));
+    if (q) memcpy(q, qw, (m - n + 1) * sizeof(uint32_t));
+    free(w);
+    free(qw);
+    free(t);
+    free(p);
+}
+
+// like bigint_divmod with the divisor prepared by bigint_divisor_init.
+// quo or rem may be NULL, either may alias a
+void bigint_divmod_pre(BigInt *quo, BigInt *rem, BigInt *a, const BigIntDivisor *div) {
+    size_t an = bigint_used(a);
+    size_t n = div->n;
+    bool q_neg = a->is_negative != div->is_negative;
+    bool r_neg = a->is_negative;
+
+    if (an < n) {
+        if (rem) bigint_deep_copy(rem, a);
+        if (quo) bigint_set_zero(quo);
+        return;
+    }
+
+    if (n == 1) {
+        uint32_t r;
+        if (quo) {
+            // quotient limbs are written in place, a is read ahead of every write
+            if (quo != a) bigint_reserve_limbs(quo, an);
+            else bigint_make_unique(quo);
+            r = bigint_limbs_divmod_1_pre(quo->buf, a->buf, an, div->limbs[0], div->shift, div->inv);
+            bigint_set_used(quo, bigint_limbs_normalize(quo->buf, an));
+            quo->is_negative = q_neg && bigint_used(quo) != 0;
+        } else {
+            r = bigint_limbs_divmod_1_pre(NULL, a->buf, an, div->limbs[0], div->shift, div->inv);
+        }
+        if (rem) {
+            bigint_from_limbs(rem, &r, 1);
+            rem->is_negative = r_neg && r != 0;
+        }
+        return;
+    }
+
+    uint32_t *un = (uint32_t *)malloc((an + 1) * sizeof(uint32_t));
+    uint32_t *q = quo ? (uint32_t *)malloc((an - n + 1) * sizeof(uint32_t)) : NULL;
+    assert(un != NULL && (quo == NULL || q != NULL) && "memory allocation failed");
+    bigint_limbs_normalize_dividend(un, a->buf, an, div->shift);
+    if (div->mu) {
+        bigint_limbs_divmod_barrett(q, un, an, div);
+    } else {
+        bigint_limbs_divmod_norm(q, un, an, div->limbs, n, div->inv, NULL);
+    }
+
+    if (quo) {
+        bigint_from_limbs(quo, q, an - n + 1);
+        quo->is_negative = q_neg && bigint_used(quo) != 0;
+    }
+    if (rem) {
+        // the remainder fits in the low n limbs of un, shift it back in place
+        bigint_limbs_denormalize_rem(un, un, n, div->shift);
+        bigint_from_limbs(rem, un, n);
+        rem->is_negative = r_neg && bigint_used(rem) != 0;
+    }
+    free(un);
+    free(q);
+}
+
+void bigint_mod_pre(BigInt *rem, BigInt *a, const BigIntDivisor *div) {
+    bigint_divmod_pre(NULL, rem, a, div);
+}
+
+// dst = a >> bits on the magnitude, dst may alias a
+static void bigint_rshift_bits(BigInt *dst, BigInt *a, uint64_t bits) {
+    size_t an = bigint_used(a);
+    size_t limbs = (size_t)(bits / BASE);
+    uint32_t rem_bits = (uint32_t)(bits % BASE);
+    bool is_negative = a->is_negative;
+    if (limbs >= an) {
+        bigint_set_zero(dst);
+        return;
+    }
+
+    size_t n = an - limbs;
+    bigint_reserve_limbs(dst, n);
+    if (rem_bits) {
+        bigint_limbs_rshift(dst->buf, a->buf + limbs, n, rem_bits);
+    } else {
+        memmove(dst->buf, a->buf + limbs, n * sizeof(uint32_t));
+    }
+    n = bigint_limbs_normalize(dst->buf, n);
+    bigint_set_used(dst, n);
+    dst->is_negative = is_negative && n != 0;
+}
+
+// dst = a << bits on the magnitude, dst may alias a
+static void bigint_lshift_bits(BigInt *dst, BigInt *a, uint64_t bits) {
+    size_t an = bigint_used(a);
+    size_t limbs = (size_t)(bits / BASE);
+    uint32_t rem_bits = (uint32_t)(bits % BASE);
+    bool is_negative = a->is_negative;
+    if (an == 0) {
+        bigint_set_zero(dst);
+        return;
+    }
+
+    bigint_reserve_limbs(dst, an + limbs + 1);
+    if (rem_bits) {
+        dst->buf[an + limbs] = bigint_limbs_lshift(dst->buf + limbs, a->buf, an, rem_bits);
+    } else {
+        memmove(dst->buf + limbs, a->buf, an * sizeof(uint32_t));
+        dst->buf[an + limbs] = 0;
+    }
+    memset(dst->buf, 0, limbs * sizeof(uint32_t));
+    bigint_set_used(dst, bigint_limbs_normalize(dst->buf, an + limbs + 1));
+    dst->is_negative = is_negative;
+}
+
+// dst = floor(sqrt(a)), the root of the top half of the bits gives a starting point above
+// the answer that is already correct to half the precision, so only the last couple of
+// Newton steps run at full size
+void bigint_sqrt(BigInt *dst, BigInt *a) {
+    assert(!a->is_negative && "square root of a negative number");
+    size_t an = bigint_used(a);
+    uint64_t bits = an ? (uint64_t)(an - 1) * BASE + bigint_limb_bitlen(a->buf[an - 1]) : 0;
+
+    if (bits <= 64) {
+        uint64_t v = an ? a->buf[0] : 0;
+        if (an > 1) v |= (uint64_t)a->buf[1] << 32;
+        // ceil(v / 2) without the overflow of (v + 1) / 2 at UINT64_MAX
+        uint64_t x = v, y = x / 2 + (x & 1);
+        while (y < x) {
+            x = y;
+            y = (x + v / x) / 2;
+        }
+        bigint_set_uint64(dst, x);
+        return;
+    }
+
+    // sqrt(a) < (floor(sqrt(a >> 2k)) + 1) << k
+    uint64_t k = bits / 4;
+    BigInt x = bigint_alloc();
+    BigInt y = bigint_alloc();
+    bigint_rshift_bits(&y, a, 2 * k);
+    bigint_sqrt(&x, &y);
+    naive_add(&x, 1);
+    bigint_lshift_bits(&x, &x, k);
+
+    // y = (x + a / x) / 2 decreases monotonically until it reaches floor(sqrt(a))
+    for (;;) {
+        bigint_divmod(&y, NULL, a, &x);
+        bigint_add_signed(&y, &y, &x, false);
+        bigint_rshift_bits(&y, &y, 1);
+        if (bigint_limbs_cmp(y.buf, bigint_used(&y), x.buf, bigint_used(&x)) >= 0) break;
+        BigInt t = x; x = y; y = t;
+    }
+
+    bigint_deep_copy(dst, &x);
+    bigint_free(&x);
+    bigint_free(&y);
+}
+
+BigIntStatus bigint_mul_ctx(BigInt *dst, BigInt *a, BigInt *b, BigIntCtx *ctx) {
+    size_t an = bigint_used(a);
+    size_t bn = bigint_used(b);
+    bool is_negative = a->is_negative != b->is_negative;
+    bool done;
+
+    if (an == 0 || bn == 0) {
+        bigint_set_zero(dst);
+        return BIGINT_OK;
+    }
+
+    if (dst != a && dst != b) {
+        bigint_reserve_limbs(dst, an + bn);
+        if (a == b) {
+            done = bigint_limbs_sqr(dst->buf, a->buf, an, ctx);
+        } else {
+            done = bigint_limbs_mul(dst->buf, a->buf, an, b->buf, bn, ctx);
+        }
+    } else {
+        // output aliases an operand, build the product in a fresh buffer
+        size_t cap = an + bn + 2;
+        uint32_t *r = bigint_buf_alloc(cap);
+        if (a == b) {
+            done = bigint_limbs_sqr(r, a->buf, an, ctx);
+        } else {
+            done = bigint_limbs_mul(r, a->buf, an, b->buf, bn, ctx);
+        }
+        bigint_buf_release(dst->buf);
+        dst->buf = r;
+        dst->capacity = cap;
+        dst->size = 1;
+    }
+    // a cancelled product leaves partial limbs behind, everything above size has to read as zero
+    if (!done) memset(dst->buf, 0, (an + bn) * sizeof(uint32_t));
+    bigint_set_used(dst, done ? bigint_limbs_normalize(dst->buf, an + bn) : 0);
+    dst->is_negative = done && is_negative;
+    return done ? BIGINT_OK : BIGINT_CANCELLED;
+}
+
+void bigint_mul(BigInt *dst, BigInt *a, BigInt *b) {
+    bigint_mul_ctx(dst, a, b, NULL);
+}
+
+// upper bound of log2(a) in Q16 fixed point, a must be non zero
+static uint64_t bigint_log2_upper_q16(const uint32_t *a, size_t n) {
+    uint64_t bits = (uint64_t)(n - 1) * BASE + bigint_limb_bitlen(a[n - 1]);
+
+    // take the top 32 bits with the msb at bit 31, round up if anything was cut off
+    uint32_t shift = BASE - bigint_limb_bitlen(a[n - 1]);
+    uint64_t top = (uint64_t)a[n - 1] << shift;
+    bool exact = true;
+    if (n > 1) {
+        if (shift) top |= a[n - 2] >> (BASE - shift);
+        exact = (a[n - 2] << shift) == 0;
+        for (size_t i = 0; exact && i + 2 < n; i++) {
+            exact = a[i] == 0;
+        }
+    }
+    if (!exact) top++;
+
+    // y = top / 2^31 in [1, 2] kept in Q30, every step rounds up so the result stays an upper bound
+    uint64_t y = (top + 1) >> 1;
+    uint64_t frac = 0;
+    for (int i = 15; i >= 0; i--) {
+        y = (y * y + (1ULL << 30) - 1) >> 30;
+        if (y >= (1ULL << 31)) {
+            frac |= 1ULL << i;
+            y = (y + 1) >> 1;
+        }
+    }
+    return ((bits - 1) << 16) + frac + 1;
+}
+
+// window width for sliding window exponentiation based on the number of exponent bits
+static uint32_t bigint_pow_window(uint32_t exp_bits) {
+    if (exp_bits < 8) return 1;
+    if (exp_bits < 24) return 2;
+    if (exp_bits < 80) return 3;
+    if (exp_bits < 240) return 4;
+    if (exp_bits < 672) return 5;
+    return 6;
+}
+
+static BigIntStatus bigint_pow_limbs(BigInt *dst, const uint32_t *base, size_t bn, bool is_negative, uint64_t exp,
+                                     BigIntCtx *ctx) {
+    BigIntCtx inner_ctx;
+    BigIntCtx *inner = bigint_ctx_inner(ctx, &inner_ctx);
+    bool done = true;
+
+    bn = bigint_limbs_normalize(base, bn);
+    if (exp == 0 || bn == 0) {
+        bigint_set_zero(dst);
+        if (exp == 0) dst->buf[0] = 1;
+        return BIGINT_OK;
+    }
+
+    // split base into odd * 2^tz, the power of two goes into a single shift at the end
+    size_t zero_limbs = 0;
+    while (base[zero_limbs] == 0) {
+        zero_limbs++;
+    }
+    uint32_t zero_bits = bigint_limb_ctz(base[zero_limbs]);
+    uint64_t tz = (uint64_t)zero_limbs * BASE + zero_bits;
+    assert((tz == 0 || exp <= UINT64_MAX / tz) && "result too large");
+    uint64_t shift = tz * exp;
+
+    // calloc so optimizing compilers can see odd is initialized even where they lose track of on > 0
+    size_t on = bn - zero_limbs;
+    uint32_t *odd = (uint32_t *)calloc(on, sizeof(uint32_t));
+    assert(odd != NULL && "memory allocation failed");
+    if (zero_bits) {
+        bigint_limbs_rshift(odd, base + zero_limbs, on, zero_bits);
+    } else {
+        memcpy(odd, base + zero_limbs, on * sizeof(uint32_t));
+    }
+    on = bigint_limbs_normalize(odd, on);
+
+    // size the result up front from an upper bound of exp * log2(odd)
+    uint64_t log2_odd = bigint_log2_upper_q16(odd, on);
+    assert(exp <= UINT64_MAX / log2_odd && "result too large");
+    uint64_t odd_bits = ((exp * log2_odd) >> 16) + 1;
+    size_t rcap = (size_t)(odd_bits / BASE) + 3;
+
+    uint32_t *r = (uint32_t *)calloc(rcap, sizeof(uint32_t));
+    uint32_t *t = (uint32_t *)calloc(rcap, sizeof(uint32_t));
+    assert(r != NULL && t != NULL && "memory allocation failed");
+    size_t rn;
+
+    if (on == 1 && odd[0] == 1) {
+        r[0] = 1;
+        rn = 1;
+    } else {
+        uint32_t exp_bits = (exp >> 32) ? BASE + bigint_limb_bitlen((uint32_t)(exp >> 32))
+                                        : bigint_limb_bitlen((uint32_t)exp);
+        uint32_t k = bigint_pow_window(exp_bits);
+
+        // table of odd powers odd^1, odd^3, ..., odd^(2^k - 1)
+        size_t table_len = (size_t)1 << (k - 1);
+        uint32_t **table = (uint32_t **)calloc(table_len, sizeof(uint32_t *));
+        size_t *table_n = (size_t *)malloc(table_len * sizeof(size_t));
+        assert(table != NULL && table_n != NULL && "memory allocation failed");
+        table[0] = odd;
+        table_n[0] = on;
+        if (table_len > 1) {
+            uint32_t *odd_sq = (uint32_t *)malloc(2 * on * sizeof(uint32_t));
+            assert(odd_sq != NULL && "memory allocation failed");
+            done = bigint_limbs_sqr(odd_sq, odd, on, inner);
+            size_t sqn = bigint_limbs_normalize(odd_sq, 2 * on);
+            for (size_t i = 1; done && i < table_len; i++) {
+                table[i] = (uint32_t *)malloc((table_n[i - 1] + sqn) * sizeof(uint32_t));
+                assert(table[i] != NULL && "memory allocation failed");
+                done = bigint_limbs_mul(table[i], table[i - 1], table_n[i - 1], odd_sq, sqn, inner);
+                table_n[i] = bigint_limbs_normalize(table[i], table_n[i - 1] + sqn);
+            }
+            free(odd_sq);
+        }
+
+        // scan the exponent from msb to lsb, each window is an odd run of at most k bits
+        bool first = true;
+        rn = 0;
+        int64_t i = exp_bits - 1;
+        while (done && i >= 0) {
+            if (bigint_ctx_poll(ctx, exp_bits - 1 - i, exp_bits)) {
+                done = false;
+                break;
+            }
+            if (((exp >> i) & 1) == 0) {
+                done = bigint_limbs_sqr(t, r, rn, inner);
+                rn = bigint_limbs_normalize(t, 2 * rn);
+                uint32_t *tmp = r; r = t; t = tmp;
+                i--;
+                continue;
+            }
+
+            int64_t j = i - k + 1;
+            if (j < 0) j = 0;
+            while (((exp >> j) & 1) == 0) {
+                j++;
+            }
+            uint64_t window = (exp >> j) & ((1ULL << (i - j + 1)) - 1);
+            size_t idx = (size_t)(window >> 1);
+
+            if (first) {
+                memcpy(r, table[idx], table_n[idx] * sizeof(uint32_t));
+                rn = table_n[idx];
+                first = false;
+            } else {
+                for (int64_t l = j; done && l <= i; l++) {
+                    done = bigint_limbs_sqr(t, r, rn, inner);
+                    rn = bigint_limbs_normalize(t, 2 * rn);
+                    uint32_t *tmp = r; r = t; t = tmp;
+                }
+                done = done && bigint_limbs_mul(t, r, rn, table[idx], table_n[idx], inner);
+                rn = bigint_limbs_normalize(t, rn + table_n[idx]);
+                uint32_t *tmp = r; r = t; t = tmp;
+            }
+            i = j - 1;
+        }
+
+        for (size_t l = 1; l < table_len; l++) {
+            free(table[l]);
+        }
+        free(table);
+        free(table_n);
+    }
+
+    if (!done) {
+        bigint_set_zero(dst);
+        free(odd);
+        free(r);
+        free(t);
+        return BIGINT_CANCELLED;
+    }
+
+    // write odd^exp << shift straight into the destination
+    size_t limb_shift = (size_t)(shift / BASE);
+    uint32_t bit_shift = (uint32_t)(shift % BASE);
+    size_t total = limb_shift + rn + 1;
+    bigint_reserve_limbs(dst, total);
+    memset(dst->buf, 0, limb_shift * sizeof(uint32_t));
+    if (bit_shift) {
+        dst->buf[limb_shift + rn] = bigint_limbs_lshift(dst->buf + limb_shift, r, rn, bit_shift);
+    } else {
+        memcpy(dst->buf + limb_shift, r, rn * sizeof(uint32_t));
+        dst->buf[limb_shift + rn] = 0;
+    }
+    bigint_set_used(dst, bigint_limbs_normalize(dst->buf, total));
+    dst->is_negative = is_negative && (exp & 1);
+
+    free(odd);
+    free(r);
+    free(t);
+    return BIGINT_OK;
+}
+
+BigIntStatus bigint_pow_ctx(BigInt *dst, BigInt *base, uint64_t exp, BigIntCtx *ctx) {
+    return bigint_pow_limbs(dst, base->buf, bigint_used(base), base->is_negative, exp, ctx);
+}
+
+void bigint_pow(BigInt *dst, BigInt *base, uint64_t exp) {
+    bigint_pow_limbs(dst, base->buf, bigint_used(base), base->is_negative, exp, NULL);
+}
+
+void bigint_ui_pow_ui(BigInt *dst, uint32_t base, uint64_t exp) {
+    bigint_pow_limbs(dst, &base, 1, false, exp, NULL);
+}
+
+void bigint_left_shift(BigInt *bigint, uint32_t shift_by) {
+    assert(shift_by < 32 && "Cannot shift more than 31 bits at a time");
+    // this function iterates from MSB to LSB with a 32 bit window
+    // each iteration current window is shifted by `shift_by`
+    // and the bits that will get discarded in the next iteration are stored in discarded
+    // then the discarded bits from next window is added to current window
+
+    if(shift_by == 0) {
+        return;
+    }
+    bigint_make_unique(bigint);
+    
+    for (int i = bigint->size - 1; i > 0; i--) {
+        bigint->buf[i] <<= shift_by;
+        uint32_t discarded = (bigint->buf[i - 1] >> (BASE - shift_by)) & ((1U << shift_by) - 1);
+        bigint->buf[i] |= discarded;
+    }
+    
+    // handle overflow that may happend after left shift 
+    if(BIGINT_GUARD(bigint) != 0){
+        bigint_increment_size(bigint);
+    }
+    bigint->buf[0] <<= shift_by;
+}
+
+void bigint_right_shift(BigInt *bigint, uint32_t shift_by) {
+    assert(shift_by < 32 && "Cannot shift more than 31 bits at a time");
+    // this function iterates from LSB to MSB with a 32 bit window
+    // each iteration current window is right shifted by `shift_by`
+    // and the bits that will get discarded in the next iteration are stored in discarded
+    // then the discarded bits from next window is added to current window
+
+    if (shift_by == 0) {
+        return;
+    }
+    bigint_make_unique(bigint);
+
+    for (size_t i = 0; i < bigint->size - 1; i++) {
+        bigint->buf[i] >>= shift_by;
+        uint32_t discarded = bigint->buf[i + 1] & ((1 << shift_by) - 1U);
+        bigint->buf[i] |= discarded << (BASE - shift_by);
+    }
+
+    // handle size reduction
+    if (bigint->size > 2 && bigint->buf[bigint->size - 2] == 0) {
+        bigint->size--;
+    }
+}
+
+#if defined(__SIZEOF_INT128__)
+// 10^18 normalized by 4 bits and its reciprocal, each pass peels 18 digits with a
+// 128 by 64 bit step per pair of limbs
+#define BIGINT_DEC_CHUNK 1000000000000000000ULL
+#define BIGINT_DEC_CHUNK_DIGITS 18
+#define BIGINT_DEC_CHUNK_SHIFT 4
+#define BIGINT_DEC_CHUNK_INV 0x2725dd1d243aba0eULL
+
+// the 64 bit word made of limbs 2k and 2k + 1 of an n limb array
+static inline uint64_t bigint_limbs_word64(const uint32_t *a, size_t n, size_t k) {
+    return a[2 * k] | (2 * k + 1 < n ? (uint64_t)a[2 * k + 1] << 32 : 0);
+}
+
+// q = a / 10^18, returns a % 10^18, q may alias a
+static uint64_t bigint_limbs_divmod_dec(uint32_t *q, const uint32_t *a, size_t n) {
+    const uint64_t d = BIGINT_DEC_CHUNK << BIGINT_DEC_CHUNK_SHIFT;
+    size_t words = (n + 1) / 2;
+    if (n == 0) return 0;
+    uint64_t r = bigint_limbs_word64(a, n, words - 1) >> (64 - BIGINT_DEC_CHUNK_SHIFT);
+    for (size_t k = words; k-- > 0;) {
+        uint64_t u0 = bigint_limbs_word64(a, n, k) << BIGINT_DEC_CHUNK_SHIFT;
+        if (k > 0) u0 |= bigint_limbs_word64(a, n, k - 1) >> (64 - BIGINT_DEC_CHUNK_SHIFT);
+
+        unsigned __int128 qq = (unsigned __int128)BIGINT_DEC_CHUNK_INV * r + (((unsigned __int128)r << 64) | u0);
+        uint64_t qk = (uint64_t)(qq >> 64) + 1;
+        r = u0 - qk * d;
+        if (r > (uint64_t)qq) {
+            qk--;
+            r += d;
+        }
+        if (r >= d) {
+            qk++;
+            r -= d;
+        }
+        q[2 * k] = (uint32_t)qk;
+        if (2 * k + 1 < n) q[2 * k + 1] = (uint32_t)(qk >> 32);
+    }
+    return r >> BIGINT_DEC_CHUNK_SHIFT;
+}
+#else
+#define BIGINT_DEC_CHUNK 1000000000u
+#define BIGINT_DEC_CHUNK_DIGITS 9
+
+// q = a / 10^9, returns a % 10^9, q may alias a. the compiler already turns the
+// constant divisor into a reciprocal multiply
+static uint64_t bigint_limbs_divmod_dec(uint32_t *q, const uint32_t *a, size_t n) {
+    uint64_t rem = 0;
+    for (size_t i = n; i > 0; i--) {
+        uint64_t cur = (rem << 32) | a[i - 1];
+        q[i - 1] = (uint32_t)(cur / BIGINT_DEC_CHUNK);
+        rem = cur % BIGINT_DEC_CHUNK;
+    }
+    return rem;
+}
+#endif
+
+BigIntStatus bigint_to_dec_str_ctx(BigInt bigint, char *str_buf, size_t str_buf_size, BigIntCtx *ctx) {
+    // divide the bigint successivly by 10^18 (10^9 without 128 bit integers) and push the
+    // remainders to a string buffer
+    size_t n = bigint_used(&bigint);
+    size_t total = n;
+    size_t i = 0;
+    size_t work = 0;
+    uint32_t *dividend = (uint32_t *)malloc((n ? n : 1) * sizeof(uint32_t));
+    assert(dividend != NULL && "memory allocation failed");
+    memcpy(dividend, bigint.buf, n * sizeof(uint32_t));
+
+    do {
+        work += n;
+        if (ctx && work >= BIGINT_CTX_POLL_WORK) {
+            work = 0;
+            if (bigint_ctx_poll(ctx, total - n, total)) {
+                free(dividend);
+                if (str_buf_size > 0) str_buf[0] = '\0';
+                return BIGINT_CANCELLED;
+            }
+        }
+        uint64_t rem = bigint_limbs_divmod_dec(dividend, dividend, n);
+        n = bigint_limbs_normalize(dividend, n);
+        // the most significant chunk is written without leading zeros
+        for (int d = 0; d < BIGINT_DEC_CHUNK_DIGITS && (n > 0 || rem > 0 || d == 0); d++) {
+            assert(i < str_buf_size && "buffer overflow");
+            str_buf[i++] = rem % 10 + '0';
+            rem /= 10;
+        }
+    } while (n > 0);
+
+    free(dividend);
+
+    if(bigint.is_negative && !(i == 1 && str_buf[0] == '0')) {
+        assert(i < str_buf_size && "buffer overflow");
+        str_buf[i] = '-';
+        ++i;
+    }
+    if (i < str_buf_size) {
+        str_buf[i] = '\0';
+    }
+    
+    // reverse string buffer
+    size_t left = 0, right = --i;
+    while (left < right) {
+        char temp = str_buf[left];
+        str_buf[left] = str_buf[right];
+        str_buf[right] = temp;
+        left++;
+        right--;
+    }
+    return BIGINT_OK;
+}
+
+void bigint_to_dec_str(BigInt bigint, char *str_buf, size_t str_buf_size) {
+    bigint_to_dec_str_ctx(bigint, str_buf, str_buf_size, NULL);
+}
+
+bool bigint_isequal_uint32(BigInt a, uint32_t b) {
+    if (a.buf[0] != b) {
+        return false;
+    }
+    for (size_t i = 1; i < a.size; i++) {
+        if (a.buf[i] != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// makes dst reference the buffer of src, dst must be initialized (or zeroed) since its
+// old buffer is released
+void bigint_shallow_copy(BigInt *dst, BigInt *src) {
+    if (dst->buf == src->buf) {
+        *dst = *src;
+        return;
+    }
+    BigInt shared = bigint_share(src);
+    bigint_buf_release(dst->buf);
+    *dst = shared;
+}
+
+void bigint_deep_copy(BigInt *dst, BigInt *src) {
+    if (dst == src) return;
+    size_t size = src->size;
+    bigint_reserve_limbs(dst, size);
+    memcpy(dst->buf, src->buf, sizeof(src->buf[0]) * size);
+    if (dst->size > size) {
+        memset(dst->buf + size, 0, (dst->size - size) * sizeof(dst->buf[0]));
+    }
+    dst->size = size;
+    dst->is_negative = src->is_negative;
+}
+
+// copies n little endian limbs into dst as a non negative value
+void bigint_from_limbs(BigInt *dst, const uint32_t *limbs, size_t n) {
+    n = bigint_limbs_normalize(limbs, n);
+    bigint_reserve_limbs(dst, n);
+    memcpy(dst->buf, limbs, n * sizeof(uint32_t));
+    bigint_set_used(dst, n);
+    dst->is_negative = 0;
+}
+
+// copies the low n limbs of |src| into limbs, returns false if the magnitude did not fit
+bool bigint_to_limbs(BigInt *src, uint32_t *limbs, size_t n) {
+    size_t used = bigint_used(src);
+    size_t copy = used < n ? used : n;
+    memcpy(limbs, src->buf, copy * sizeof(uint32_t));
+    memset(limbs + copy, 0, (n - copy) * sizeof(uint32_t));
+    return used <= n;
+}
+
+// ---- decimal limbs ----
+
+#define BIGINT_DEC_LIMB 1000000000u
+#define BIGINT_DEC_LIMB_DIGITS 9
+
+// makes sure num can hold `limbs` limbs, growing by the growth policy like BigInt does
+static void bigint_dec_reserve(BigIntDec *num, size_t limbs) {
+    if (num->capacity >= limbs) return;
+    size_t grown = bigint_grown_capacity(num->capacity);
+    size_t new_cap = grown > limbs ? grown : limbs;
+    num->buf = bigint_buf_realloc(num->buf, num->capacity, new_cap);
+    num->capacity = new_cap;
+}
+
+// drops leading zero limbs from the first `size` limbs and keeps zero non negative
+static void bigint_dec_set_size(BigIntDec *num, size_t size) {
+    while (size > 0 && num->buf[size - 1] == 0) {
+        size--;
+    }
+    num->size = size;
+    if (size == 0) num->is_negative = 0;
+}
+
+BigIntDec bigint_dec_alloc(void) {
+    BigIntDec num;
+    num.buf = bigint_buf_alloc(INIT_SIZE);
+    num.size = 0;
+    num.capacity = INIT_SIZE;
+    num.is_negative = 0;
+    return num;
+}
+
+void bigint_dec_free(BigIntDec *num) {
+    bigint_buf_release(num->buf);
+    num->buf = NULL;
+    num->size = 0;
+    num->capacity = 0;
+}
+
+// parses an optionally negative decimal string, 9 digits per limb starting from the right
+void bigint_dec_set(BigIntDec *num, const char *str) {
+    bool is_negative = str[0] == '-';
+    if (is_negative) str++;
+    size_t len = strlen(str);
+    assert(len > 0 && "empty decimal string");
+    bigint_dec_reserve(num, len / BIGINT_DEC_LIMB_DIGITS + 1);
+
+    size_t n = 0;
+    for (size_t end = len; end > 0; n++) {
+        size_t start = end > BIGINT_DEC_LIMB_DIGITS ? end - BIGINT_DEC_LIMB_DIGITS : 0;
+        uint32_t limb = 0;
+        for (size_t i = start; i < end; i++) {
+            assert(str[i] >= '0' && str[i] <= '9' && "invalid decimal digit");
+            limb = limb * 10 + (uint32_t)(str[i] - '0');
+        }
+        num->buf[n] = limb;
+        end = start;
+    }
+    num->is_negative = is_negative;
+    bigint_dec_set_size(num, n);
+}
+
+// number of decimal digits of |num|, 1 for zero
+size_t bigint_dec_digits(BigIntDec *num) {
+    if (num->size == 0) return 1;
+    size_t digits = (num->size - 1) * BIGINT_DEC_LIMB_DIGITS;
+    for (uint32_t top = num->buf[num->size - 1]; top > 0; top /= 10) {
+        digits++;
+    }
+    return digits;
+}
+
+// writes num in decimal, needs bigint_dec_digits(num) + 1 bytes for a negative value and
+// one more for the terminating NUL, which is left out when it does not fit
+void bigint_dec_to_str(BigIntDec *num, char *str_buf, size_t str_buf_size) {
+    size_t len = bigint_dec_digits(num) + num->is_negative;
+    assert(len <= str_buf_size && "buffer overflow");
+    if (len < str_buf_size) str_buf[len] = '\0';
+    if (num->size == 0) {
+        str_buf[0] = '0';
+        return;
+    }
+
+    // every limb below the top one is zero padded to 9 digits, filled in from the right
+    char *p = str_buf + len;
+    for (size_t i = 0; i + 1 < num->size; i++) {
+        uint32_t limb = num->buf[i];
+        for (int d = 0; d < BIGINT_DEC_LIMB_DIGITS; d++) {
+            *--p = (char)('0' + limb % 10);
+            limb /= 10;
+        }
+    }
+    for (uint32_t top = num->buf[num->size - 1]; top > 0; top /= 10) {
+        *--p = (char)('0' + top % 10);
+    }
+    if (num->is_negative) *--p = '-';
+}
+
+// compares with signs, returns -1, 0 or 1
+int bigint_dec_cmp(BigIntDec *a, BigIntDec *b) {
+    if (a->is_negative != b->is_negative) return a->is_negative ? -1 : 1;
+    int cmp = bigint_limbs_cmp(a->buf, a->size, b->buf, b->size);
+    return a->is_negative ? -cmp : cmp;
+}
+
+// dst = a + b, or a - b when negate_b is set, dst may alias a or b
+static void bigint_dec_add_signed(BigIntDec *dst, BigIntDec *a, BigIntDec *b, bool negate_b) {
+    bool a_neg = a->is_negative;
+    bool b_neg = b->is_negative != negate_b;
+
+    // make `a` the operand with the larger magnitude
+    int cmp = bigint_limbs_cmp(a->buf, a->size, b->buf, b->size);
+    if (cmp < 0) {
+        BigIntDec *t = a; a = b; b = t;
+        bool tneg = a_neg; a_neg = b_neg; b_neg = tneg;
+    }
+    size_t an = a->size, bn = b->size;
+
+    bigint_dec_reserve(dst, an + 1);
+    uint32_t *r = dst->buf;
+    if (a_neg == b_neg) {
+        uint32_t carry = 0;
+        for (size_t i = 0; i < an; i++) {
+            uint32_t sum = a->buf[i] + (i < bn ? b->buf[i] : 0) + carry;
+            carry = sum >= BIGINT_DEC_LIMB;
+            r[i] = carry ? sum - BIGINT_DEC_LIMB : sum;
+        }
+        r[an] = carry;
+        an++;
+    } else {
+        uint32_t borrow = 0;
+        for (size_t i = 0; i < an; i++) {
+            uint32_t sub = (i < bn ? b->buf[i] : 0) + borrow;
+            borrow = a->buf[i] < sub;
+            r[i] = borrow ? a->buf[i] + BIGINT_DEC_LIMB - sub : a->buf[i] - sub;
+        }
+    }
+    dst->is_negative = a_neg;
+    bigint_dec_set_size(dst, an);
+}
+
+void bigint_dec_add(BigIntDec *dst, BigIntDec *a, BigIntDec *b) {
+    bigint_dec_add_signed(dst, a, b, false);
+}
+
+void bigint_dec_sub(BigIntDec *dst, BigIntDec *a, BigIntDec *b) {
+    bigint_dec_add_signed(dst, a, b, true);
+}
+
+// dst = a * multiplier, dst may alias a
+void bigint_dec_mul_ui(BigIntDec *dst, BigIntDec *a, uint32_t multiplier) {
+    size_t n = a->size;
+    bool is_negative = a->is_negative;
+    bigint_dec_reserve(dst, n + 2);
+
+    // a limb times a 32 bit multiplier plus the carry stays far below 2^64
+    uint64_t carry = 0;
+    for (size_t i = 0; i < n; i++) {
+        uint64_t t = (uint64_t)a->buf[i] * multiplier + carry;
+        dst->buf[i] = (uint32_t)(t % BIGINT_DEC_LIMB);
+        carry = t / BIGINT_DEC_LIMB;
+    }
+    while (carry) {
+        dst->buf[n++] = (uint32_t)(carry % BIGINT_DEC_LIMB);
+        carry /= BIGINT_DEC_LIMB;
+    }
+    dst->is_negative = is_negative;
+    bigint_dec_set_size(dst, n);
+}
+
+// peels decimal limbs off a copy of |src| with the same division bigint_to_dec_str uses
+void bigint_dec_from_bigint(BigIntDec *dst, BigInt *src) {
+    size_t n = bigint_used(src);
+    // a binary limb holds less than 10 decimal digits, so 2 decimal limbs per binary limb is plenty
+    bigint_dec_reserve(dst, 2 * n + 2);
+    uint32_t *dividend = (uint32_t *)malloc((n ? n : 1) * sizeof(uint32_t));
+    assert(dividend != NULL && "memory allocation failed");
+    memcpy(dividend, src->buf, n * sizeof(uint32_t));
+
+    size_t out = 0;
+    while (n > 0) {
+        uint64_t rem = bigint_limbs_divmod_dec(dividend, dividend, n);
+        n = bigint_limbs_normalize(dividend, n);
+        for (int k = 0; k < BIGINT_DEC_CHUNK_DIGITS / BIGINT_DEC_LIMB_DIGITS; k++) {
+            dst->buf[out++] = (uint32_t)(rem % BIGINT_DEC_LIMB);
+            rem /= BIGINT_DEC_LIMB;
+        }
+    }
+    free(dividend);
+    dst->is_negative = src->is_negative;
+    bigint_dec_set_size(dst, out);
+}
+
+// Horner evaluation from the top decimal limb, one multiply by 10^9 and add per limb
+void bigint_dec_to_bigint(BigInt *dst, BigIntDec *src) {
+    // every decimal limb adds less than 30 bits
+    bigint_reserve_limbs(dst, (src->size * 30 + BASE - 1) / BASE + 1);
+    uint32_t *r = dst->buf;
+    size_t rn = 0;
+    for (size_t i = src->size; i > 0; i--) {
+        uint64_t carry = src->buf[i - 1];
+        for (size_t j = 0; j < rn; j++) {
+            uint64_t t = (uint64_t)r[j] * BIGINT_DEC_LIMB + carry;
+            r[j] = (uint32_t)t;
+            carry = t >> 32;
+        }
+        if (carry) r[rn++] = (uint32_t)carry;
+    }
+    bigint_set_used(dst, rn);
+    dst->is_negative = src->is_negative && rn != 0;
+}
+
+// ---- residue number system ----
+
+// a basis node whose primes are at most this many is reduced prime by prime instead of splitting
+#define BIGINT_RNS_LEAF_PRIMES 16
+
+// a * b mod p for a, b < p, with inv = bigint_limb_reciprocal(p << 1). every prime has 31 bits
+// so p << 1 is normalized, and a * b << 1 < p (p << 1) keeps the high limb below the divisor
+static inline uint32_t bigint_rns_mulmod(uint32_t a, uint32_t b, uint32_t p, uint32_t inv) {
+    uint64_t x = (uint64_t)a * b << 1;
+    uint32_t r;
+    bigint_limb_div_pre((uint32_t)(x >> 32), (uint32_t)x, p << 1, inv, &r);
+    return r >> 1;
+}
+
+// deterministic Miller-Rabin, the bases 2, 7 and 61 decide every n below 4759123141
+static bool bigint_rns_is_prime(uint32_t n) {
+    static const uint32_t bases[] = {2, 7, 61};
+    if (n < 2 || n % 2 == 0) return n == 2;
+    uint32_t d = n - 1;
+    int s = 0;
+    while (d % 2 == 0) {
+        d /= 2;
+        s++;
+    }
+    for (int i = 0; i < 3; i++) {
+        uint64_t b = bases[i] % n;
+        uint64_t x = 1;
+        if (b == 0) continue;
+        for (uint32_t e = d; e; e >>= 1) {
+            if (e & 1) x = x * b % n;
+            b = b * b % n;
+        }
+        bool witness = x != 1 && x != n - 1;
+        for (int r = 1; r < s && witness; r++) {
+            x = x * x % n;
+            witness = x != n - 1;
+        }
+        if (witness) return false;
+    }
+    return true;
+}
+
+// a^-1 mod p for a prime p not dividing a, by the extended Euclidean algorithm
+static uint32_t bigint_rns_invmod(uint32_t a, uint32_t p) {
+    int64_t t = 0, new_t = 1;
+    int64_t r = p, new_r = a % p;
+    while (new_r != 0) {
+        int64_t q = r / new_r;
+        int64_t tmp = t - q * new_t;
+        t = new_t;
+        new_t = tmp;
+        tmp = r - q * new_r;
+        r = new_r;
+        new_r = tmp;
+    }
+    return (uint32_t)(t < 0 ? t + p : t);
+}
+
+// residues of -x from those of x
+static void bigint_rns_negate(uint32_t *res, const BigIntRnsBasis *basis) {
+    for (size_t i = 0; i < basis->k; i++) {
+        res[i] = res[i] ? basis->primes[i] - res[i] : 0;
+    }
+}
+
+// products of primes[lo, hi) for node and everything below it, children of node are 2 node + 1
+// and 2 node + 2
+static void bigint_rns_tree_build(BigIntRnsBasis *basis, size_t node, size_t lo, size_t hi) {
+    BigInt *prod = &basis->tree[node];
+    *prod = bigint_alloc();
+    if (hi - lo == 1) {
+        bigint_set_uint64(prod, basis->primes[lo]);
+    } else {
+        size_t mid = lo + (hi - lo) / 2;
+        bigint_rns_tree_build(basis, 2 * node + 1, lo, mid);
+        bigint_rns_tree_build(basis, 2 * node + 2, mid, hi);
+        bigint_mul(prod, &basis->tree[2 * node + 1], &basis->tree[2 * node + 2]);
+    }
+    bigint_divisor_init(&basis->tree_div[node], prod);
+}
+
+static void bigint_rns_tree_free(BigIntRnsBasis *basis, size_t node, size_t lo, size_t hi) {
+    if (hi - lo > 1) {
+        size_t mid = lo + (hi - lo) / 2;
+        bigint_rns_tree_free(basis, 2 * node + 1, lo, mid);
+        bigint_rns_tree_free(basis, 2 * node + 2, mid, hi);
+    }
+    bigint_free(&basis->tree[node]);
+    bigint_divisor_free(&basis->tree_div[node]);
+}
+
+// crt[i] for the primes under node, `outside` is the product of all other primes of the basis
+// modulo the product of this node. pushed down like a remainder tree so M / p_i mod p_i costs
+// O(M(n) log k) instead of k^2 limb products
+static void bigint_rns_crt_tree(BigIntRnsBasis *basis, size_t node, size_t lo, size_t hi, BigInt *outside) {
+    if (hi - lo == 1) {
+        uint32_t p = basis->primes[lo];
+        uint32_t r = bigint_limbs_divmod_1_pre(NULL, outside->buf, bigint_used(outside), p << 1, 1, basis->inv[lo]);
+        basis->crt[lo] = bigint_rns_invmod(r, p);
+        return;
+    }
+    size_t mid = lo + (hi - lo) / 2;
+    size_t left = 2 * node + 1, right = 2 * node + 2;
+    BigInt t = bigint_alloc();
+    bigint_mul(&t, outside, &basis->tree[right]);
+    bigint_mod_pre(&t, &t, &basis->tree_div[left]);
+    bigint_rns_crt_tree(basis, left, lo, mid, &t);
+    bigint_mul(&t, outside, &basis->tree[left]);
+    bigint_mod_pre(&t, &t, &basis->tree_div[right]);
+    bigint_rns_crt_tree(basis, right, mid, hi, &t);
+    bigint_free(&t);
+}
+
+void bigint_rns_basis_init(BigIntRnsBasis *basis, uint64_t bits) {
+    // k primes above 2^30 make M > 2^30k > 2^(bits + 1), so the symmetric range covers 2^bits
+    size_t k = (size_t)((bits + 1) / 30 + 1);
+    basis->k = k;
+    basis->primes = (uint32_t *)malloc(k * sizeof(uint32_t));
+    basis->inv = (uint32_t *)malloc(k * sizeof(uint32_t));
+    basis->crt = (uint32_t *)malloc(k * sizeof(uint32_t));
+    basis->tree = (BigInt *)calloc(4 * k, sizeof(BigInt));
+    basis->tree_div = (BigIntDivisor *)calloc(4 * k, sizeof(BigIntDivisor));
+    assert(basis->primes != NULL && basis->inv != NULL && basis->crt != NULL && basis->tree != NULL &&
+           basis->tree_div != NULL && "memory allocation failed");
+
+    // the largest primes below 2^31, 2^31 - 1 itself is one
+    uint32_t candidate = 0x7fffffffu;
+    for (size_t i = 0; i < k; candidate -= 2) {
+        assert(candidate > (1u << 30) && "too many bits for a basis of 31 bit primes");
+        if (!bigint_rns_is_prime(candidate)) continue;
+        basis->primes[i] = candidate;
+        basis->inv[i] = bigint_limb_reciprocal(candidate << 1);
+        i++;
+    }
+
+    bigint_rns_tree_build(basis, 0, 0, k);
+    BigInt one = bigint_alloc();
+    bigint_set_uint64(&one, 1);
+    bigint_rns_crt_tree(basis, 0, 0, k, &one);
+    bigint_free(&one);
+
+    basis->half = bigint_alloc();
+    bigint_rshift_bits(&basis->half, &basis->tree[0], 1);
+}
+
+void bigint_rns_basis_free(BigIntRnsBasis *basis) {
+    if (basis->k) bigint_rns_tree_free(basis, 0, 0, basis->k);
+    bigint_free(&basis->half);
+    free(basis->primes);
+    free(basis->inv);
+    free(basis->crt);
+    free(basis->tree);
+    free(basis->tree_div);
+    memset(basis, 0, sizeof(*basis));
+}
+
+BigIntRns bigint_rns_alloc(const BigIntRnsBasis *basis) {
+    BigIntRns num = {(uint32_t *)calloc(basis->k, sizeof(uint32_t)), basis};
+    assert(num.res != NULL && "memory allocation failed");
+    return num;
+}
+
+void bigint_rns_free(BigIntRns *num) {
+    free(num->res);
+    num->res = NULL;
+    num->basis = NULL;
+}
+
+void bigint_rns_set_int64(BigIntRns *num, int64_t value) {
+    const BigIntRnsBasis *basis = num->basis;
+    uint64_t magnitude = value < 0 ? -(uint64_t)value : (uint64_t)value;
+    uint32_t limbs[2] = {(uint32_t)magnitude, (uint32_t)(magnitude >> 32)};
+    for (size_t i = 0; i < basis->k; i++) {
+        num->res[i] = bigint_limbs_divmod_1_pre(NULL, limbs, 2, basis->primes[i] << 1, 1, basis->inv[i]);
+    }
+    if (value < 0) bigint_rns_negate(num->res, basis);
+}
+
+// residues of |x| for the primes under node, |x| is below the product of the parent node
+static void bigint_rns_reduce(const BigIntRnsBasis *basis, size_t node, size_t lo, size_t hi, BigInt *x,
+                              uint32_t *res) {
+    if (hi - lo <= BIGINT_RNS_LEAF_PRIMES) {
+        size_t n = bigint_used(x);
+        for (size_t i = lo; i < hi; i++) {
+            res[i] = bigint_limbs_divmod_1_pre(NULL, x->buf, n, basis->primes[i] << 1, 1, basis->inv[i]);
+        }
+        return;
+    }
+    // values shorter than a child's product go down unchanged
+    size_t mid = lo + (hi - lo) / 2;
+    size_t n = bigint_used(x);
+    BigInt r = bigint_alloc();
+    const BigIntDivisor *left = &basis->tree_div[2 * node + 1];
+    const BigIntDivisor *right = &basis->tree_div[2 * node + 2];
+    if (n >= left->n) bigint_mod_pre(&r, x, left);
+    bigint_rns_reduce(basis, 2 * node + 1, lo, mid, n >= left->n ? &r : x, res);
+    if (n >= right->n) bigint_mod_pre(&r, x, right);
+    bigint_rns_reduce(basis, 2 * node + 2, mid, hi, n >= right->n ? &r : x, res);
+    bigint_free(&r);
+}
+
+// remainder tree, src is taken modulo M first
+void bigint_rns_from_bigint(BigIntRns *dst, BigInt *src) {
+    const BigIntRnsBasis *basis = dst->basis;
+    BigInt x = bigint_alloc();
+    if (bigint_used(src) >= basis->tree_div[0].n) {
+        bigint_mod_pre(&x, src, &basis->tree_div[0]);
+        bigint_rns_reduce(basis, 0, 0, basis->k, &x, dst->res);
+    } else {
+        bigint_rns_reduce(basis, 0, 0, basis->k, src, dst->res);
+    }
+    if (src->is_negative) bigint_rns_negate(dst->res, basis);
+    bigint_free(&x);
+}
+
+// sum of c_i * (product under node) / p_i over the primes under node, c_i = res_i * crt_i mod p_i
+static void bigint_rns_combine(const BigIntRnsBasis *basis, size_t node, size_t lo, size_t hi, const uint32_t *res,
+                               BigInt *out) {
+    if (hi - lo == 1) {
+        bigint_set_uint64(out, bigint_rns_mulmod(res[lo], basis->crt[lo], basis->primes[lo], basis->inv[lo]));
+        return;
+    }
+    size_t mid = lo + (hi - lo) / 2;
+    BigInt left = bigint_alloc();
+    BigInt right = bigint_alloc();
+    bigint_rns_combine(basis, 2 * node + 1, lo, mid, res, &left);
+    bigint_rns_combine(basis, 2 * node + 2, mid, hi, res, &right);
+    bigint_mul(out, &left, &basis->tree[2 * node + 2]);
+    bigint_mul(&left, &right, &basis->tree[2 * node + 1]);
+    bigint_add(out, out, &left);
+    bigint_free(&left);
+    bigint_free(&right);
+}
+
+// CRT over the product tree, the result lies in (-M / 2, M / 2]
+void bigint_rns_to_bigint(BigInt *dst, BigIntRns *src) {
+    const BigIntRnsBasis *basis = src->basis;
+    BigInt sum = bigint_alloc();
+    bigint_rns_combine(basis, 0, 0, basis->k, src->res, &sum);
+
+    // the sum is below k M
+    bigint_mod_pre(dst, &sum, &basis->tree_div[0]);
+    if (bigint_limbs_cmp(dst->buf, bigint_used(dst), basis->half.buf, bigint_used(&basis->half)) > 0) {
+        bigint_sub(dst, dst, &basis->tree[0]);
+    }
+    bigint_free(&sum);
+}
+
+// the per prime loops have no dependencies between iterations, any of dst, a and b may alias
+void bigint_rns_add_range(BigIntRns *dst, BigIntRns *a, BigIntRns *b, size_t lo, size_t hi) {
+    assert(dst->basis == a->basis && a->basis == b->basis && "residues of different bases");
+    assert(lo <= hi && hi <= a->basis->k && "residue range out of bounds");
+    const uint32_t *p = a->basis->primes;
+    for (size_t i = lo; i < hi; i++) {
+        uint32_t s = a->res[i] + b->res[i];
+        dst->res[i] = s >= p[i] ? s - p[i] : s;
+    }
+}
+
+void bigint_rns_sub_range(BigIntRns *dst, BigIntRns *a, BigIntRns *b, size_t lo, size_t hi) {
+    assert(dst->basis == a->basis && a->basis == b->basis && "residues of different bases");
+    assert(lo <= hi && hi <= a->basis->k && "residue range out of bounds");
+    const uint32_t *p = a->basis->primes;
+    for (size_t i = lo; i < hi; i++) {
+        uint32_t d = a->res[i] - b->res[i];
+        dst->res[i] = a->res[i] < b->res[i] ? d + p[i] : d;
+    }
+}
+
+void bigint_rns_mul_range(BigIntRns *dst, BigIntRns *a, BigIntRns *b, size_t lo, size_t hi) {
+    assert(dst->basis == a->basis && a->basis == b->basis && "residues of different bases");
+    assert(lo <= hi && hi <= a->basis->k && "residue range out of bounds");
+    const BigIntRnsBasis *basis = a->basis;
+    for (size_t i = lo; i < hi; i++) {
+        dst->res[i] = bigint_rns_mulmod(a->res[i], b->res[i], basis->primes[i], basis->inv[i]);
+    }
+}
+
+void bigint_rns_add(BigIntRns *dst, BigIntRns *a, BigIntRns *b) {
+    bigint_rns_add_range(dst, a, b, 0, a->basis->k);
+}
+
+void bigint_rns_sub(BigIntRns *dst, BigIntRns *a, BigIntRns *b) {
+    bigint_rns_sub_range(dst, a, b, 0, a->basis->k);
+}
+
+void bigint_rns_mul(BigIntRns *dst, BigIntRns *a, BigIntRns *b) {
+    bigint_rns_mul_range(dst, a, b, 0, a->basis->k);
+}
+
+// ---- bitwise operations ----
+// negative values behave as infinite two's complement, like they would in a signed
+// machine word that never runs out of sign bits
+
+#if defined(__AVX2__)
+#define BIGINT_LOGIC_SIMD(OP128, OP256)                                           \
+    for (; i + 8 <= n; i += 8) {                                                  \
+        __m256i x = _mm256_loadu_si256((const __m256i *)(a + i));                 \
+        __m256i y = _mm256_loadu_si256((const __m256i *)(b + i));                 \
+        _mm256_storeu_si256((__m256i *)(r + i), OP256(x, y));                     \
+    }
+#elif defined(__SSE2__)
+#define BIGINT_LOGIC_SIMD(OP128, OP256)                                           \
+    for (; i + 4 <= n; i += 4) {                                                  \
+        __m128i x = _mm_loadu_si128((const __m128i *)(a + i));                    \
+        __m128i y = _mm_loadu_si128((const __m128i *)(b + i));                    \
+        _mm_storeu_si128((__m128i *)(r + i), OP128(x, y));                        \
+    }
+#else
+#define BIGINT_LOGIC_SIMD(OP128, OP256)
+#endif
+
+// r = a OP b over n limbs, r may alias a or b
+#define BIGINT_DEFINE_LOGIC_KERNEL(NAME, OP, OP128, OP256)                                    \
+    static void bigint_limbs_##NAME(uint32_t *r, const uint32_t *a, const uint32_t *b, size_t n) { \
+        size_t i = 0;                                                                         \
+        BIGINT_LOGIC_SIMD(OP128, OP256)                                                       \
+        for (; i < n; i++) r[i] = a[i] OP b[i];                                               \
+    }
+
+BIGINT_DEFINE_LOGIC_KERNEL(and, &, _mm_and_si128, _mm256_and_si256)
+BIGINT_DEFINE_LOGIC_KERNEL(or, |, _mm_or_si128, _mm256_or_si256)
+BIGINT_DEFINE_LOGIC_KERNEL(xor, ^, _mm_xor_si128, _mm256_xor_si256)
+
+static uint32_t bigint_limb_popcount(uint32_t x) {
+#if defined(__GNUC__)
+    return __builtin_popcount(x);
+#else
+    x = x - ((x >> 1) & 0x55555555);
+    x = (x & 0x33333333) + ((x >> 2) & 0x33333333);
+    x = (x + (x >> 4)) & 0x0F0F0F0F;
+    return (x * 0x01010101) >> 24;
+#endif
+}
+
+// popcount of a (or of a ^ b when b is not NULL), two limbs per hardware popcnt
+static uint64_t bigint_limbs_popcount(const uint32_t *a, const uint32_t *b, size_t n) {
+    uint64_t count = 0;
+    size_t i = 0;
+#if defined(__GNUC__)
+    for (; i + 2 <= n; i += 2) {
+        uint64_t x, y = 0;
+        memcpy(&x, a + i, sizeof(x));
+        if (b) memcpy(&y, b + i, sizeof(y));
+        count += __builtin_popcountll(x ^ y);
+    }
+#endif
+    for (; i < n; i++) {
+        count += bigint_limb_popcount(a[i] ^ (b ? b[i] : 0));
+    }
+    return count;
+}
+
+// r = -r modulo 2^(32 * n)
+static void bigint_limbs_negate(uint32_t *r, size_t n) {
+    uint64_t carry = 1;
+    for (size_t i = 0; i < n; i++) {
+        carry += (uint32_t)~r[i];
+        r[i] = (uint32_t)carry;
+        carry >>= 32;
+    }
+}
+
+// n limb two's complement form of a, n must be larger than the used limbs of a
+static uint32_t *bigint_to_twos(BigInt *a, size_t n) {
+    size_t an = bigint_used(a);
+    uint32_t *t = (uint32_t *)calloc(n, sizeof(uint32_t));
+    assert(t != NULL && "memory allocation failed");
+    memcpy(t, a->buf, an * sizeof(uint32_t));
+    if (a->is_negative && an) bigint_limbs_negate(t, n);
+    return t;
+}
+
+// loads a two's complement limb array into dst, t is clobbered
+static void bigint_from_twos(BigInt *dst, uint32_t *t, size_t n) {
+    bool is_negative = t[n - 1] >> 31;
+    if (is_negative) bigint_limbs_negate(t, n);
+    bigint_from_limbs(dst, t, n);
+    dst->is_negative = is_negative;
+}
+
+// limb i of the two's complement form of a without materializing it, low is the index of
+// the lowest non zero limb: -m = ~(m - 1) leaves the limbs below it zero, negates that one
+// and inverts everything above
+static uint32_t bigint_twos_limb(BigInt *a, size_t an, size_t low, size_t i) {
+    uint32_t limb = i < an ? a->buf[i] : 0;
+    if (!a->is_negative || an == 0) return limb;
+    if (i < low) return 0;
+    return i == low ? (uint32_t)-limb : ~limb;
+}
+
+static size_t bigint_lowest_limb(BigInt *a, size_t an) {
+    size_t low = 0;
+    while (low < an && a->buf[low] == 0) {
+        low++;
+    }
+    return low;
+}
+
+enum { BIGINT_AND, BIGINT_OR, BIGINT_XOR };
+
+static void bigint_logic(BigInt *dst, BigInt *a, BigInt *b, int op) {
+    size_t an = bigint_used(a);
+    size_t bn = bigint_used(b);
+
+    if (!a->is_negative && !b->is_negative) {
+        // both non negative, combine the common limbs and copy the tail of the longer one
+        if (an < bn) {
+            BigInt *t = a; a = b; b = t;
+            size_t tn = an; an = bn; bn = tn;
+        }
+        size_t n = op == BIGINT_AND ? bn : an;
+        bigint_reserve_limbs(dst, n);
+        switch (op) {
+        case BIGINT_AND: bigint_limbs_and(dst->buf, a->buf, b->buf, bn); break;
+        case BIGINT_OR: bigint_limbs_or(dst->buf, a->buf, b->buf, bn); break;
+        default: bigint_limbs_xor(dst->buf, a->buf, b->buf, bn); break;
+        }
+        if (n > bn && dst->buf != a->buf) {
+            memcpy(dst->buf + bn, a->buf + bn, (n - bn) * sizeof(uint32_t));
+        }
+        bigint_set_used(dst, bigint_limbs_normalize(dst->buf, n));
+        dst->is_negative = 0;
+        return;
+    }
+
+    // one more limb than either operand holds the sign
+    size_t n = (an > bn ? an : bn) + 1;
+    uint32_t *ta = bigint_to_twos(a, n);
+    uint32_t *tb = bigint_to_twos(b, n);
+    switch (op) {
+    case BIGINT_AND: bigint_limbs_and(ta, ta, tb, n); break;
+    case BIGINT_OR: bigint_limbs_or(ta, ta, tb, n); break;
+    default: bigint_limbs_xor(ta, ta, tb, n); break;
+    }
+    bigint_from_twos(dst, ta, n);
+    free(ta);
+    free(tb);
+}
+
+void bigint_and(BigInt *dst, BigInt *a, BigInt *b) {
+    bigint_logic(dst, a, b, BIGINT_AND);
+}
+
+void bigint_or(BigInt *dst, BigInt *a, BigInt *b) {
+    bigint_logic(dst, a, b, BIGINT_OR);
+}
+
+void bigint_xor(BigInt *dst, BigInt *a, BigInt *b) {
+    bigint_logic(dst, a, b, BIGINT_XOR);
+}
+
+// dst = ~a = -a - 1
+void bigint_com(BigInt *dst, BigInt *a) {
+    BigInt one = bigint_alloc();
+    bigint_set_uint64(&one, 1);
+    bigint_add_signed(dst, a, &one, false);
+    dst->is_negative = !dst->is_negative && bigint_used(dst) != 0;
+    bigint_free(&one);
+}
+
+// number of set bits, UINT64_MAX for negative values which have infinitely many
+uint64_t bigint_popcount(BigInt *a) {
+    size_t an = bigint_used(a);
+    if (a->is_negative && an) return UINT64_MAX;
+    return bigint_limbs_popcount(a->buf, NULL, an);
+}
+
+// number of differing bits, UINT64_MAX if the signs differ
+uint64_t bigint_hamdist(BigInt *a, BigInt *b) {
+    size_t an = bigint_used(a);
+    size_t bn = bigint_used(b);
+    bool a_neg = a->is_negative && an;
+    bool b_neg = b->is_negative && bn;
+    if (a_neg != b_neg) return UINT64_MAX;
+
+    if (!a_neg) {
+        if (an < bn) {
+            BigInt *t = a; a = b; b = t;
+            size_t tn = an; an = bn; bn = tn;
+        }
+        return bigint_limbs_popcount(a->buf, b->buf, bn) + bigint_limbs_popcount(a->buf + bn, NULL, an - bn);
+    }
+
+    size_t n = (an > bn ? an : bn) + 1;
+    uint32_t *ta = bigint_to_twos(a, n);
+    uint32_t *tb = bigint_to_twos(b, n);
+    uint64_t count = bigint_limbs_popcount(ta, tb, n);
+    free(ta);
+    free(tb);
+    return count;
+}
+
+// index of the first bit at or above start_bit equal to `value`, UINT64_MAX if there is none
+static uint64_t bigint_scan(BigInt *a, uint64_t start_bit, bool value) {
+    size_t an = bigint_used(a);
+    size_t low = bigint_lowest_limb(a, an);
+    bool sign = a->is_negative && an;
+    uint32_t flip = value ? 0 : 0xFFFFFFFF;
+    size_t i = (size_t)(start_bit / BASE);
+
+    // past the magnitude every bit equals the sign
+    if (i >= an) return sign == value ? start_bit : UINT64_MAX;
+
+    uint32_t limb = (bigint_twos_limb(a, an, low, i) ^ flip) & (0xFFFFFFFFU << (start_bit % BASE));
+    while (limb == 0) {
+        if (++i >= an) return sign == value ? (uint64_t)an * BASE : UINT64_MAX;
+        limb = bigint_twos_limb(a, an, low, i) ^ flip;
+    }
+    return (uint64_t)i * BASE + bigint_limb_ctz(limb);
+}
+
+uint64_t bigint_scan0(BigInt *a, uint64_t start_bit) {
+    return bigint_scan(a, start_bit, false);
+}
+
+uint64_t bigint_scan1(BigInt *a, uint64_t start_bit) {
+    return bigint_scan(a, start_bit, true);
+}
+
+bool bigint_tstbit(BigInt *a, uint64_t bit) {
+    size_t an = bigint_used(a);
+    size_t i = (size_t)(bit / BASE);
+    if (i >= an) return a->is_negative && an;
+    return (bigint_twos_limb(a, an, bigint_lowest_limb(a, an), i) >> (bit % BASE)) & 1;
+}
+
+static void bigint_change_bit(BigInt *a, uint64_t bit, bool value) {
+    size_t an = bigint_used(a);
+    size_t i = (size_t)(bit / BASE);
+    uint32_t mask = 1U << (bit % BASE);
+
+    if (!a->is_negative || an == 0) {
+        if (!value && i >= an) return;
+        bigint_reserve_limbs(a, i + 1);
+        if (value) {
+            a->buf[i] |= mask;
+        } else {
+            a->buf[i] &= ~mask;
+        }
+        bigint_set_used(a, bigint_limbs_normalize(a->buf, i >= an ? i + 1 : an));
+        a->is_negative = a->is_negative && bigint_used(a);
+        return;
+    }
+
+    // negative: edit the two's complement form, bits past it are already set
+    if (value && i >= an) return;
+    size_t n = (i + 1 > an ? i + 1 : an) + 1;
+    uint32_t *t = bigint_to_twos(a, n);
+    if (value) {
+        t[i] |= mask;
+    } else {
+        t[i] &= ~mask;
+    }
+    bigint_from_twos(a, t, n);
+    free(t);
+}
+
+void bigint_setbit(BigInt *a, uint64_t bit) {
+    bigint_change_bit(a, bit, true);
+}
+
+void bigint_clrbit(BigInt *a, uint64_t bit) {
+    bigint_change_bit(a, bit, false);
+}
+
+// ceil(2^32 / log2(base)) for base 2..36
+static const uint64_t bigint_digits_per_bit_q32[] = {
+    4294967296ull, 2709822658u, 2147483648u, 1849741733u, 1661520156u,
+    1529898220u, 1431655766u, 1354911329u, 1292913987u, 1241523976u,
+    1198050830u, 1160664036u, 1128071164u, 1099331346u, 1073741824u,
+    1050766078u, 1029986702u, 1011073585u, 993761859u, 977836273u,
+    963119892u, 949465784u, 936750802u, 924870867u, 913737343u,
+    903274220u, 893415895u, 884105414u, 875293063u, 866935226u,
+    858993460u, 851433730u, 844225783u, 837342624u, 830760078u,
+};
+
+// number of digits of |a| in the given base, exact for powers of two and otherwise at most one too big
+size_t bigint_sizeinbase(BigInt *a, int base) {
+    assert(base >= 2 && base <= 36 && "base must be between 2 and 36");
+    size_t an = bigint_used(a);
+    if (an == 0) return 1;
+    uint64_t bits = (uint64_t)(an - 1) * BASE + bigint_limb_bitlen(a->buf[an - 1]);
+
+    if ((base & (base - 1)) == 0) {
+        uint32_t log2_base = bigint_limb_bitlen((uint32_t)base) - 1;
+        return (size_t)((bits + log2_base - 1) / log2_base);
+    }
+    uint64_t c = bigint_digits_per_bit_q32[base - 2];
+    return (size_t)((bits >> 32) * c + (((bits & 0xFFFFFFFF) * c) >> 32) + 1);
+}
+
+// ---- binary splitting ----
+
+typedef struct {
+    BigIntSeries *series;
+    uint64_t n1, n2;
+    bool need_p;
+    unsigned threads;
+    BigInt P, Q, B, T;
+} BigIntSplit;
+
+static void bigint_binsplit_run(BigIntSplit *job);
+
+#ifdef BIGINT_THREADS
+static void *bigint_binsplit_thread(void *arg) {
+    bigint_binsplit_run((BigIntSplit *)arg);
+    return NULL;
+}
+#endif
+
+static void bigint_binsplit_run(BigIntSplit *job) {
+    BigIntSeries *series = job->series;
+
+    if (job->n2 - job->n1 == 1) {
+        BigInt a = bigint_alloc();
+        bigint_set_uint64(&job->B, 1);
+        series->term(job->n1, &job->P, &job->Q, &a, &job->B, series->user);
+        bigint_mul(&job->T, &a, &job->P);
+        bigint_free(&a);
+        return;
+    }
+
+    uint64_t mid = job->n1 + (job->n2 - job->n1) / 2;
+    BigIntSplit left = {series, job->n1, mid, true, job->threads / 2,
+                        bigint_alloc(), bigint_alloc(), bigint_alloc(), bigint_alloc()};
+    BigIntSplit right = {series, mid, job->n2, job->need_p, job->threads - job->threads / 2,
+                         bigint_alloc(), bigint_alloc(), bigint_alloc(), bigint_alloc()};
+
+#ifdef BIGINT_THREADS
+    pthread_t thread;
+    bool spawned = job->threads > 1 && pthread_create(&thread, NULL, bigint_binsplit_thread, &left) == 0;
+    if (!spawned) bigint_binsplit_run(&left);
+    bigint_binsplit_run(&right);
+    if (spawned) pthread_join(thread, NULL);
+#else
+    bigint_binsplit_run(&left);
+    bigint_binsplit_run(&right);
+#endif
+
+    // T = B_r * Q_r * T_l + B_l * P_l * T_r
+    BigInt tmp = bigint_alloc();
+    bigint_mul(&job->T, &right.Q, &left.T);
+    bigint_mul(&tmp, &left.P, &right.T);
+    if (series->uses_b) {
+        bigint_mul(&job->T, &job->T, &right.B);
+        bigint_mul(&tmp, &tmp, &left.B);
+        bigint_mul(&job->B, &left.B, &right.B);
+    }
+    bigint_add_signed(&job->T, &job->T, &tmp, false);
+    bigint_free(&tmp);
+
+    if (job->need_p) {
+        bigint_mul(&job->P, &left.P, &right.P);
+    }
+    bigint_mul(&job->Q, &left.Q, &right.Q);
+
+    bigint_free(&left.P);
+    bigint_free(&left.Q);
+    bigint_free(&left.B);
+    bigint_free(&left.T);
+    bigint_free(&right.P);
+    bigint_free(&right.Q);
+    bigint_free(&right.B);
+    bigint_free(&right.T);
+}
+
+// P, Q, B and T must be initialized, P and B may be NULL when the caller does not need them
+void bigint_binsplit(BigIntSeries *series, uint64_t n1, uint64_t n2, BigInt *P, BigInt *Q, BigInt *B, BigInt *T) {
+    assert(n1 < n2 && "empty series");
+    BigIntSplit job = {series, n1, n2, P != NULL, series->threads ? series->threads : 1,
+                       bigint_alloc(), bigint_alloc(), bigint_alloc(), bigint_alloc()};
+    bigint_binsplit_run(&job);
+
+    if (P) bigint_shallow_copy(P, &job.P);
+    if (B) bigint_shallow_copy(B, &job.B);
+    bigint_shallow_copy(Q, &job.Q);
+    bigint_shallow_copy(T, &job.T);
+    bigint_free(&job.P);
+    bigint_free(&job.Q);
+    bigint_free(&job.B);
+    bigint_free(&job.T);
+}
+
+// extra digits carried through the evaluation so truncation errors stay below the result
+#define BIGINT_CONST_GUARD_DIGITS 8
+
+// dst = num / den with the guard digits stripped
+static void bigint_const_finish(BigInt *dst, BigInt *num, BigInt *den) {
+    BigInt scale = bigint_alloc();
+    bigint_ui_pow_ui(&scale, 10, BIGINT_CONST_GUARD_DIGITS);
+    bigint_divmod(dst, NULL, num, den);
+    bigint_divmod(dst, NULL, dst, &scale);
+    bigint_free(&scale);
+}
+
+// Chudnovsky: 1/pi = 12 sum (-1)^k (6k)! (13591409 + 545140134k) / ((3k)! (k!)^3 640320^(3k + 3/2))
+static void bigint_pi_term(uint64_t k, BigInt *p, BigInt *q, BigInt *a, BigInt *b, void *user) {
+    (void)b;
+    (void)user;
+    if (k == 0) {
+        bigint_set_uint64(p, 1);
+        bigint_set_uint64(q, 1);
+    } else {
+        // p(k) = -(6k - 5)(2k - 1)(6k - 1), q(k) = k^3 * 640320^3 / 24
+        bigint_set_uint64(p, 6 * k - 5);
+        naive_mult(p, (uint32_t)(2 * k - 1));
+        naive_mult(p, (uint32_t)(6 * k - 1));
+        p->is_negative = 1;
+
+        bigint_set_uint64(q, 10939058860032000ULL);
+        naive_mult(q, (uint32_t)k);
+        naive_mult(q, (uint32_t)k);
+        naive_mult(q, (uint32_t)k);
+    }
+    bigint_set_uint64(a, 13591409 + 545140134 * k);
+}
+
+// dst = floor(pi * 10^digits)
+void bigint_const_pi(BigInt *dst, uint64_t digits, unsigned threads) {
+    uint64_t prec = digits + BIGINT_CONST_GUARD_DIGITS;
+    // every term adds log10(640320^3 / 1728) ~ 14.18 digits
+    uint64_t terms = prec * 100 / 1418 + 2;
+    BigIntSeries series = {bigint_pi_term, NULL, false, threads};
+    BigInt Q = bigint_alloc();
+    BigInt T = bigint_alloc();
+    bigint_binsplit(&series, 0, terms, NULL, &Q, NULL, &T);
+
+    // pi = 426880 * sqrt(10005) * Q / T
+    BigInt root = bigint_alloc();
+    BigInt num = bigint_alloc();
+    bigint_ui_pow_ui(&root, 10, 2 * prec);
+    naive_mult(&root, 10005);
+    bigint_sqrt(&num, &root);
+    naive_mult(&num, 426880);
+    bigint_mul(&num, &num, &Q);
+
+    bigint_const_finish(dst, &num, &T);
+
+    bigint_free(&root);
+    bigint_free(&num);
+    bigint_free(&Q);
+    bigint_free(&T);
+}
+
+// e = sum 1/n!
+static void bigint_e_term(uint64_t n, BigInt *p, BigInt *q, BigInt *a, BigInt *b, void *user) {
+    (void)b;
+    (void)user;
+    bigint_set_uint64(p, 1);
+    bigint_set_uint64(q, n ? n : 1);
+    bigint_set_uint64(a, 1);
+}
+
+// dst = floor(e * 10^digits)
+void bigint_const_e(BigInt *dst, uint64_t digits, unsigned threads) {
+    uint64_t prec = digits + BIGINT_CONST_GUARD_DIGITS;
+    // stop once n! > 10^prec, floor(log2(n)) underestimates so this errs on the side of more terms
+    uint64_t target_bits = prec * 3322 / 1000 + 2;
+    uint64_t bits = 0, terms = 1;
+    while (bits < target_bits) {
+        terms++;
+        bits += bigint_limb_bitlen((uint32_t)terms) - 1;
+    }
+
+    BigIntSeries series = {bigint_e_term, NULL, false, threads};
+    BigInt Q = bigint_alloc();
+    BigInt T = bigint_alloc();
+    bigint_binsplit(&series, 0, terms + 1, NULL, &Q, NULL, &T);
+
+    BigInt scale = bigint_alloc();
+    bigint_ui_pow_ui(&scale, 10, prec);
+    bigint_mul(&T, &T, &scale);
+    bigint_const_finish(dst, &T, &Q);
+
+    bigint_free(&scale);
+    bigint_free(&Q);
+    bigint_free(&T);
+}
+
+// ln2 = 2 atanh(1/3) = sum 2 / ((2k + 1) 3^(2k + 1))
+static void bigint_ln2_term(uint64_t k, BigInt *p, BigInt *q, BigInt *a, BigInt *b, void *user) {
+    (void)user;
+    bigint_set_uint64(p, 1);
+    bigint_set_uint64(q, k ? 9 : 3);
+    bigint_set_uint64(a, 2);
+    bigint_set_uint64(b, 2 * k + 1);
+}
+
+// dst = floor(ln(2) * 10^digits)
+void bigint_const_ln2(BigInt *dst, uint64_t digits, unsigned threads) {
+    uint64_t prec = digits + BIGINT_CONST_GUARD_DIGITS;
+    // every term adds log10(9) ~ 0.954 digits
+    uint64_t terms = prec * 1000 / 954 + 2;
+    BigIntSeries series = {bigint_ln2_term, NULL, true, threads};
+    BigInt Q = bigint_alloc();
+    BigInt B = bigint_alloc();
+    BigInt T = bigint_alloc();
+    bigint_binsplit(&series, 0, terms, NULL, &Q, &B, &T);
+
+    BigInt scale = bigint_alloc();
+    bigint_ui_pow_ui(&scale, 10, prec);
+    bigint_mul(&T, &T, &scale);
+    bigint_mul(&Q, &Q, &B);
+    bigint_const_finish(dst, &T, &Q);
+
+    bigint_free(&scale);
+    bigint_free(&Q);
+    bigint_free(&B);
+    bigint_free(&T);
 }
 
 // writes content of buff from most significant to least to stdout
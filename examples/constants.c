@@ -0,0 +1,62 @@
+// computes pi, e or ln2 to the given number of digits with binary splitting,
+// doubles as an end to end benchmark of multiplication, division and decimal output
+//
+// usage: constants [pi|e|ln2] [digits] [threads] [-q]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define BIG_INT_IMPLEMENTATION
+#include "../BigInt.h"
+
+static double seconds_since(struct timespec start) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (now.tv_sec - start.tv_sec) + (now.tv_nsec - start.tv_nsec) / 1e9;
+}
+
+int main(int argc, char **argv) {
+    const char *name = argc > 1 ? argv[1] : "pi";
+    uint64_t digits = argc > 2 ? strtoull(argv[2], NULL, 10) : 1000;
+    unsigned threads = argc > 3 ? (unsigned)atoi(argv[3]) : 4;
+    bool quiet = argc > 4 && strcmp(argv[4], "-q") == 0;
+
+    void (*fn)(BigInt *, uint64_t, unsigned) = NULL;
+    if (strcmp(name, "pi") == 0) fn = bigint_const_pi;
+    if (strcmp(name, "e") == 0) fn = bigint_const_e;
+    if (strcmp(name, "ln2") == 0) fn = bigint_const_ln2;
+    if (fn == NULL) {
+        fprintf(stderr, "unknown constant %s, expected pi, e or ln2\n", name);
+        return 1;
+    }
+
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    BigInt n = bigint_alloc();
+    fn(&n, digits, threads);
+    double compute = seconds_since(start);
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    size_t buf_size = digits + 16;
+    char *buf = (char *)calloc(buf_size, 1);
+    bigint_to_dec_str(n, buf, buf_size);
+    double convert = seconds_since(start);
+
+    if (!quiet) {
+        // floor(c * 10^digits) has a single integer digit for all three constants
+        // except ln2 which has none
+        if (strcmp(name, "ln2") == 0) {
+            printf("0.%s\n", buf);
+        } else {
+            printf("%c.%s\n", buf[0], buf + 1);
+        }
+    }
+    fprintf(stderr, "%s: %lu digits, %u threads, compute %.3fs, decimal output %.3fs\n", name,
+            (unsigned long)digits, threads, compute, convert);
+
+    free(buf);
+    bigint_free(&n);
+    return 0;
+}
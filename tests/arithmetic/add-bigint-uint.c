@@ -61,5 +61,12 @@ int main() {
     // Add to negative number
     test_add("Add to negative number", "-500", 100, "-400", true);
 
+    // Addition that crosses zero
+    test_add("Add past a negative number", "-50", 100, "50", false);
+    test_add("Add to negative number to reach zero", "-100", 100, "0", false);
+
+    // Addition that borrows from the next limb of a negative number
+    test_add("Add to negative number with borrow", "-4294967296", 1, "-4294967295", true);
+
     return 0;
 }
@@ -0,0 +1,78 @@
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#define BIG_INT_IMPLEMENTATION
+#include "../../BigInt.h"
+#include "../test-check.h"
+
+static bool equals(BigInt *num, const char *expected) {
+    char buf[256];
+    bigint_to_dec_str(*num, buf, sizeof(buf));
+    if (strcmp(buf, expected) != 0 || num->is_negative != (expected[0] == '-')) {
+        printf("got      %s (is_negative %u)\nexpected %s\n", buf, num->is_negative, expected);
+        return false;
+    }
+    return true;
+}
+
+// checks a + b and a - b into a fresh result and in place over either operand
+static void run_test_case(const char *test_name, char *a_str, char *b_str, const char *exp_sum, const char *exp_diff) {
+    BigInt a = bigint_alloc();
+    BigInt b = bigint_alloc();
+    BigInt res = bigint_alloc();
+    bigint_set(&a, a_str);
+    bigint_set(&b, b_str);
+
+    bigint_add(&res, &a, &b);
+    bool ok = equals(&res, exp_sum);
+    bigint_sub(&res, &a, &b);
+    ok = equals(&res, exp_diff) && ok;
+
+    bigint_add(&a, &a, &b);
+    ok = equals(&a, exp_sum) && ok;
+    bigint_set(&a, a_str);
+    bigint_sub(&b, &a, &b);
+    ok = equals(&b, exp_diff) && ok;
+    check(test_name, ok);
+
+    bigint_free(&a);
+    bigint_free(&b);
+    bigint_free(&res);
+}
+
+int main() {
+    run_test_case("Both positive", "123", "23", "146", "100");
+    run_test_case("Both positive, smaller first", "23", "123", "146", "-100");
+    run_test_case("Negative and positive", "-123", "23", "-100", "-146");
+    run_test_case("Positive and negative", "123", "-23", "100", "146");
+    run_test_case("Both negative", "-123", "-23", "-146", "-100");
+    run_test_case("Both negative, smaller magnitude first", "-23", "-123", "-146", "100");
+    run_test_case("Equal values", "123", "123", "246", "0");
+    run_test_case("Equal negative values", "-123", "-123", "-246", "0");
+    run_test_case("Opposite values cancel", "-123", "123", "0", "-246");
+    run_test_case("Carry into a new limb", "18446744073709551615", "1", "18446744073709551616",
+                  "18446744073709551614");
+    run_test_case("Borrow through every limb", "340282366920938463463374607431768211456", "1",
+                  "340282366920938463463374607431768211457", "340282366920938463463374607431768211455");
+    run_test_case("Borrow through every limb, negative", "-340282366920938463463374607431768211456", "-1",
+                  "-340282366920938463463374607431768211457", "-340282366920938463463374607431768211455");
+    run_test_case("Mixed signs across limbs", "-18446744073709551615", "18446744073709551616", "1",
+                  "-36893488147419103231");
+    run_test_case("Zero and negative", "0", "-4294967296", "-4294967296", "4294967296");
+    run_test_case("Negative and zero", "-4294967296", "0", "-4294967296", "-4294967296");
+    run_test_case("Nearly equal magnitudes", "123456789012345678901234567890123456789",
+                  "-123456789012345678901234567890123456788", "1", "246913578024691357802469135780246913577");
+
+    // the same BigInt as both operands
+    BigInt x = bigint_alloc();
+    bigint_set(&x, "-98765432109876543210");
+    bigint_sub(&x, &x, &x);
+    check("x - x is zero", equals(&x, "0"));
+    bigint_set(&x, "-98765432109876543210");
+    bigint_add(&x, &x, &x);
+    check("x + x doubles", equals(&x, "-197530864219753086420"));
+    bigint_free(&x);
+
+    return failures != 0;
+}
@@ -0,0 +1,128 @@
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+// low threshold so the 9 limb divisor below goes through Barrett and the 2 limb one through Knuth
+#define BIGINT_BARRETT_THRESHOLD 4
+#define BIG_INT_IMPLEMENTATION
+#include "../../BigInt.h"
+#include "../test-check.h"
+
+#define A_STR                                                                                      \
+    "70550791086553325712464271575934796216507949612787315762871223209262085551582934156579298529" \
+    "447134158154952334825355911866929793071824566694145084454535257027960285323760313192443283334" \
+    "100346"
+
+static bool equals(BigInt *num, const char *expected) {
+    static char buf[1024];
+    bigint_to_dec_str(*num, buf, sizeof(buf));
+    if (strcmp(buf, expected) != 0) {
+        printf("got      %s\nexpected %s\n", buf, expected);
+        return false;
+    }
+    return true;
+}
+
+static void run_test_case(const char *test_name, char *a_str, char *d_str, const char *exp_q, const char *exp_r) {
+    BigInt a = bigint_alloc();
+    BigInt d = bigint_alloc();
+    BigInt q = bigint_alloc();
+    BigInt r = bigint_alloc();
+    bigint_set(&a, a_str);
+    bigint_set(&d, d_str);
+
+    BigIntDivisor div;
+    bigint_divisor_init(&div, &d);
+    bigint_divmod_pre(&q, &r, &a, &div);
+    bool ok = equals(&q, exp_q) && equals(&r, exp_r);
+
+    // same divisor again, remainder only and in place
+    bigint_mod_pre(&a, &a, &div);
+    ok = ok && equals(&a, exp_r);
+    check(test_name, ok);
+
+    bigint_divisor_free(&div);
+    bigint_free(&a);
+    bigint_free(&d);
+    bigint_free(&q);
+    bigint_free(&r);
+}
+
+// the divisor prepared once has to agree with bigint_divmod for every dividend it meets
+static void run_sweep(const char *test_name, uint32_t base, uint64_t exp) {
+    BigInt d = bigint_alloc();
+    BigInt a = bigint_alloc();
+    BigInt q1 = bigint_alloc(), r1 = bigint_alloc();
+    BigInt q2 = bigint_alloc(), r2 = bigint_alloc();
+    bool ok = true;
+    bigint_ui_pow_ui(&d, base, exp);
+    BigIntDivisor div;
+    bigint_divisor_init(&div, &d);
+
+    for (uint64_t k = 1; k < 120 && ok; k += 7) {
+        bigint_ui_pow_ui(&a, 3, k * 20);
+        naive_add(&a, (uint32_t)k);
+        a.is_negative = k % 2;
+        bigint_divmod_pre(&q1, &r1, &a, &div);
+        bigint_divmod(&q2, &r2, &a, &d);
+        ok = bigint_hamdist(&q1, &q2) == 0 && q1.is_negative == q2.is_negative && bigint_hamdist(&r1, &r2) == 0 &&
+             r1.is_negative == r2.is_negative;
+
+        // quotient written over the dividend
+        bigint_divmod_pre(&a, NULL, &a, &div);
+        ok = ok && bigint_hamdist(&a, &q2) == 0;
+    }
+    check(test_name, ok);
+
+    bigint_divisor_free(&div);
+    bigint_free(&d);
+    bigint_free(&a);
+    bigint_free(&q1);
+    bigint_free(&r1);
+    bigint_free(&q2);
+    bigint_free(&r2);
+}
+
+int main() {
+    run_test_case("Single limb divisor", A_STR, "1000000007",
+                  "705507905926977915635797306308766818003711770101890766915476863684282809725849673484845270900"
+                  "55444527766840640457471428664629792419416019758232946146904633999627847326365381907885609",
+                  "978901083");
+
+    run_test_case("Two limb divisor", A_STR, "2305843009213693951",
+                  "305965283866448310638820606681494617200582328453328003806325416606150283863293173792680489947"
+                  "17306567687597922802880713395431865346326405535871679770522731865996914196686245",
+                  "1044234203532696351");
+
+    run_test_case("Barrett divisor", A_STR,
+                  "3234476509624757991344647769100216810857203198904625400933895331391691459636928060001",
+                  "21812120408547394146201419743474682897317358832928686058912643040112521528779914291185082326"
+                  "779735300187010",
+                  "765019023616344249446346491014281280234057176965122389426482109459056443631533313336");
+
+    run_test_case("Negative dividend truncates toward zero", "-" A_STR,
+                  "3234476509624757991344647769100216810857203198904625400933895331391691459636928060001",
+                  "-21812120408547394146201419743474682897317358832928686058912643040112521528779914291185082326"
+                  "779735300187010",
+                  "-765019023616344249446346491014281280234057176965122389426482109459056443631533313336");
+
+    run_test_case("Negative divisor", "12345", "-7", "-1763", "4");
+    run_test_case("Dividend smaller than divisor", "12345", "2305843009213693951", "0", "12345");
+
+    run_sweep("Matches bigint_divmod, single limb", 10, 9);
+    run_sweep("Matches bigint_divmod, Knuth", 7, 30);
+    run_sweep("Matches bigint_divmod, Barrett", 7, 300);
+
+    BigInt p = bigint_alloc();
+    bigint_ui_pow_ui(&p, 2, 380);
+    check("Decimal output of an even limb count",
+          equals(&p, "24626253872746549507674400062589758628174837044040904167467683377653576107185756632133916409"
+                     "30307227550414249394176"));
+    bigint_ui_pow_ui(&p, 2, 415);
+    check("Decimal output of an odd limb count",
+          equals(&p, "84615164005151820665845159428194693098035799419427996068435045795123941278247852265624218936"
+                     "283556460491675139202989862944768"));
+    bigint_free(&p);
+
+    return failures != 0;
+}
@@ -0,0 +1,85 @@
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#define BIG_INT_IMPLEMENTATION
+#include "../../BigInt.h"
+#include "../test-check.h"
+
+static void set_karatsuba(size_t mul_limbs, size_t sqr_limbs) {
+    bigint_set_threshold(BIGINT_THRESHOLD_KARATSUBA_MUL, mul_limbs);
+    bigint_set_threshold(BIGINT_THRESHOLD_KARATSUBA_SQR, sqr_limbs);
+}
+
+// a * b once with schoolbook only and once with Karatsuba from `limbs` on
+static bool same_product(BigInt *a, BigInt *b, size_t limbs) {
+    BigInt expected = bigint_alloc();
+    BigInt res = bigint_alloc();
+    set_karatsuba(SIZE_MAX, SIZE_MAX);
+    bigint_mul(&expected, a, b);
+    set_karatsuba(limbs, limbs);
+    bigint_mul(&res, a, b);
+    bool ok = bigint_hamdist(&res, &expected) == 0 && res.is_negative == expected.is_negative;
+    bigint_free(&expected);
+    bigint_free(&res);
+    return ok;
+}
+
+static void run_products(const char *test_name, uint32_t a_base, uint64_t a_exp, uint32_t b_base, uint64_t b_exp) {
+    BigInt a = bigint_alloc();
+    BigInt b = bigint_alloc();
+    bigint_ui_pow_ui(&a, a_base, a_exp);
+    bigint_ui_pow_ui(&b, b_base, b_exp);
+    b.is_negative = true;
+
+    bool ok = true;
+    for (size_t limbs = 4; limbs <= 40 && ok; limbs += 9) {
+        ok = same_product(&a, &b, limbs) && same_product(&b, &a, limbs) && same_product(&a, &a, limbs);
+    }
+    check(test_name, ok);
+
+    bigint_free(&a);
+    bigint_free(&b);
+}
+
+int main() {
+    // read on first use, so it has to be set before anything multiplies
+    setenv("BIGINT_KARATSUBA_SQR_THRESHOLD", "5", 1);
+    setenv("BIGINT_BARRETT_THRESHOLD", "not a number", 1);
+    check("Environment overrides the default", bigint_get_threshold(BIGINT_THRESHOLD_KARATSUBA_SQR) == 5);
+    check("Malformed environment value is ignored",
+          bigint_get_threshold(BIGINT_THRESHOLD_BARRETT) == BIGINT_BARRETT_THRESHOLD);
+    check("Threshold names match their macros",
+          strcmp(bigint_threshold_name(BIGINT_THRESHOLD_KARATSUBA_MUL), "BIGINT_KARATSUBA_MUL_THRESHOLD") == 0 &&
+              strcmp(bigint_threshold_name(BIGINT_THRESHOLD_KARATSUBA_SQR), "BIGINT_KARATSUBA_SQR_THRESHOLD") == 0 &&
+              strcmp(bigint_threshold_name(BIGINT_THRESHOLD_BARRETT), "BIGINT_BARRETT_THRESHOLD") == 0);
+
+    bigint_set_threshold(BIGINT_THRESHOLD_KARATSUBA_MUL, 100);
+    bool ok = bigint_get_threshold(BIGINT_THRESHOLD_KARATSUBA_MUL) == 100;
+    bigint_set_threshold(BIGINT_THRESHOLD_KARATSUBA_MUL, 0);
+    check("Setting 0 restores the default",
+          ok && bigint_get_threshold(BIGINT_THRESHOLD_KARATSUBA_MUL) == BIGINT_KARATSUBA_MUL_THRESHOLD);
+
+    run_products("Balanced operands", 3, 2000, 7, 1150);
+    run_products("Odd limb counts", 3, 1010, 5, 1390);
+    run_products("Unbalanced operands", 3, 9000, 7, 300);
+    run_products("Very unbalanced operands", 11, 20000, 13, 80);
+
+    // sparse limbs and all ones stress the carries of the middle product
+    static uint32_t ones[125];
+    for (size_t i = 0; i < 125; i++) ones[i] = UINT32_MAX;
+    BigInt a = bigint_alloc();
+    BigInt b = bigint_alloc();
+    bigint_from_limbs(&a, ones, 125);
+    bigint_ui_pow_ui(&b, 2, 2500);
+    naive_add(&b, 1);
+    ok = true;
+    for (size_t limbs = 4; limbs <= 12 && ok; limbs++) {
+        ok = same_product(&a, &a, limbs) && same_product(&a, &b, limbs) && same_product(&b, &b, limbs);
+    }
+    check("All ones and sparse operands", ok);
+
+    bigint_free(&a);
+    bigint_free(&b);
+    return failures != 0;
+}
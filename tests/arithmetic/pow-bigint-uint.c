@@ -0,0 +1,80 @@
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#define BIG_INT_IMPLEMENTATION
+#include "../../BigInt.h"
+#include "../test-check.h"
+
+void test_pow(const char *test_name, char *base, uint64_t exp, const char *expected_result) {
+    BigInt b = bigint_alloc();
+    BigInt res = bigint_alloc();
+    char buf[1024] = "";
+
+    bigint_set(&b, base);
+    printf("%s: %s ^ %lu\n", test_name, base, (unsigned long)exp);
+
+    bigint_pow(&res, &b, exp);
+    bigint_to_dec_str(res, buf, sizeof(buf));
+    printf("Result: %s\n", buf);
+
+    if (strcmp(expected_result, buf) == 0) {
+        printf_green("pass");
+    } else {
+        printf_red("Error: Output mismatch.");
+        printf_red("Expected: \"%s\"", expected_result);
+        printf_red("Actual:   \"%s\"", buf);
+        failures++;
+    }
+    printf("------------------------------\n\n");
+    bigint_free(&b);
+    bigint_free(&res);
+}
+
+// compares bigint_ui_pow_ui against repeated naive_mult limb by limb
+void test_ui_pow_ui(const char *test_name, uint32_t base, uint64_t exp) {
+    BigInt res = bigint_alloc();
+    BigInt expected = bigint_alloc();
+
+    printf("%s: %u ^ %lu\n", test_name, base, (unsigned long)exp);
+    bigint_ui_pow_ui(&res, base, exp);
+    bigint_set(&expected, "1");
+    for (uint64_t i = 0; i < exp; i++) {
+        naive_mult(&expected, base);
+    }
+
+    size_t n = bigint_used(&expected);
+    bool match = bigint_used(&res) == n && memcmp(res.buf, expected.buf, n * sizeof(uint32_t)) == 0;
+    if (match && BIGINT_GUARD(&res) == 0) {
+        printf_green("pass");
+    } else {
+        printf_red("Error: result differs from repeated multiplication");
+        failures++;
+    }
+    printf("------------------------------\n\n");
+    bigint_free(&res);
+    bigint_free(&expected);
+}
+
+int main() {
+    test_pow("Power of two", "2", 100, "1267650600228229401496703205376");
+    test_pow("Small odd base", "3", 100, "515377520732011331036461129765621272702107522001");
+    test_pow("Zero exponent", "12345", 0, "1");
+    test_pow("Zero base", "0", 7, "0");
+    test_pow("Zero to the zero", "0", 0, "1");
+    test_pow("Negative base odd exponent", "-3", 3, "-27");
+    test_pow("Even base", "12", 20, "3833759992447475122176");
+    test_pow("Base with power of two factor", "6", 77,
+             "827268102990819696904779987451100917723545245377785847873536");
+    test_pow("Base with zero limbs", "4294967296", 5, "1461501637330902918203684832716283019655932542976");
+    test_pow("Multi limb base", "123456789012345678901234567890", 3,
+             "1881676372353657772546716040589641726257477229849409426207693797722198701224860897069000");
+    test_pow("Negative multi limb base even exponent", "-98765432109876543210", 4,
+             "95152427564533893309353806531053549932443683689636611346076755021596186236810000");
+
+    test_ui_pow_ui("Large exponent", 3, 1000);
+    test_ui_pow_ui("Very large exponent", 7, 20000);
+    test_ui_pow_ui("Exponent with long zero runs", 3, (1 << 14) + 1);
+
+    return failures != 0;
+}
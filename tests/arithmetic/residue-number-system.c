@@ -0,0 +1,190 @@
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#define BIG_INT_IMPLEMENTATION
+#include "../../BigInt.h"
+#include "../test-check.h"
+
+static bool same(BigInt *a, BigInt *b) {
+    return bigint_hamdist(a, b) == 0 && a->is_negative == b->is_negative;
+}
+
+// x survives the trip into residues and back
+static bool round_trip(const BigIntRnsBasis *basis, BigInt *x) {
+    BigIntRns r = bigint_rns_alloc(basis);
+    BigInt back = bigint_alloc();
+    bigint_rns_from_bigint(&r, x);
+    bigint_rns_to_bigint(&back, &r);
+    bool ok = same(&back, x);
+    bigint_rns_free(&r);
+    bigint_free(&back);
+    return ok;
+}
+
+// acc = (acc * t_i + t_i - 1) over the terms, on residues [lo, hi) only
+typedef struct {
+    BigIntRns *acc;
+    BigIntRns *terms;
+    BigIntRns *one;
+    size_t count;
+    size_t lo;
+    size_t hi;
+} ChainSlice;
+
+static void *run_chain_slice(void *arg) {
+    ChainSlice *slice = (ChainSlice *)arg;
+    for (size_t i = 0; i < slice->count; i++) {
+        bigint_rns_mul_range(slice->acc, slice->acc, &slice->terms[i], slice->lo, slice->hi);
+        bigint_rns_add_range(slice->acc, slice->acc, &slice->terms[i], slice->lo, slice->hi);
+        bigint_rns_sub_range(slice->acc, slice->acc, slice->one, slice->lo, slice->hi);
+    }
+    return NULL;
+}
+
+// the same chain once over all residues and once split into slices, on threads when available
+static bool chain_in_slices(const BigIntRnsBasis *basis, size_t slices) {
+    enum { TERMS = 40 };
+    BigIntRns terms[TERMS];
+    BigIntRns one = bigint_rns_alloc(basis);
+    BigIntRns whole = bigint_rns_alloc(basis);
+    BigIntRns split = bigint_rns_alloc(basis);
+    bigint_rns_set_int64(&one, 1);
+    bigint_rns_set_int64(&whole, -7);
+    bigint_rns_set_int64(&split, -7);
+    for (size_t i = 0; i < TERMS; i++) {
+        terms[i] = bigint_rns_alloc(basis);
+        bigint_rns_set_int64(&terms[i], (int64_t)(i * 2654435761u % 1000003) - 500000);
+    }
+    for (size_t i = 0; i < TERMS; i++) {
+        bigint_rns_mul(&whole, &whole, &terms[i]);
+        bigint_rns_add(&whole, &whole, &terms[i]);
+        bigint_rns_sub(&whole, &whole, &one);
+    }
+
+    ChainSlice slice[8];
+    for (size_t t = 0; t < slices; t++) {
+        slice[t] = (ChainSlice){&split, terms, &one, TERMS, basis->k * t / slices, basis->k * (t + 1) / slices};
+    }
+#ifdef BIGINT_THREADS
+    pthread_t thread[8];
+    for (size_t t = 0; t < slices; t++) pthread_create(&thread[t], NULL, run_chain_slice, &slice[t]);
+    for (size_t t = 0; t < slices; t++) pthread_join(thread[t], NULL);
+#else
+    for (size_t t = 0; t < slices; t++) run_chain_slice(&slice[t]);
+#endif
+
+    BigInt a = bigint_alloc();
+    BigInt b = bigint_alloc();
+    bigint_rns_to_bigint(&a, &whole);
+    bigint_rns_to_bigint(&b, &split);
+    bool ok = same(&a, &b) && memcmp(whole.res, split.res, basis->k * sizeof(uint32_t)) == 0;
+
+    bigint_free(&a);
+    bigint_free(&b);
+    for (size_t i = 0; i < TERMS; i++) bigint_rns_free(&terms[i]);
+    bigint_rns_free(&one);
+    bigint_rns_free(&whole);
+    bigint_rns_free(&split);
+    return ok;
+}
+
+int main() {
+    BigIntRnsBasis basis;
+    bigint_rns_basis_init(&basis, 3000);
+    bool ok = basis.k * 30 > 3001;
+    for (size_t i = 0; i < basis.k && ok; i++) {
+        ok = basis.primes[i] > (1u << 30) && basis.primes[i] < (1u << 31) &&
+             (i == 0 || basis.primes[i] < basis.primes[i - 1]);
+    }
+    check("Basis of distinct 31 bit primes", ok && basis.primes[0] == 2147483647u);
+
+    BigInt x = bigint_alloc();
+    BigInt y = bigint_alloc();
+    BigInt expected = bigint_alloc();
+    ok = round_trip(&basis, &x);
+    for (uint64_t e = 1; e < 1800 && ok; e += 131) {
+        bigint_ui_pow_ui(&x, 3, e);
+        x.is_negative = e % 2;
+        ok = round_trip(&basis, &x);
+    }
+    check("Round trip of zero and powers of three", ok);
+
+    // the symmetric range ends at floor(M / 2), one more wraps to the negative side
+    bigint_deep_copy(&x, &basis.half);
+    ok = round_trip(&basis, &x);
+    x.is_negative = true;
+    ok = ok && round_trip(&basis, &x);
+    x.is_negative = false;
+    naive_add(&x, 1);
+    BigIntRns r = bigint_rns_alloc(&basis);
+    bigint_rns_from_bigint(&r, &x);
+    bigint_rns_to_bigint(&y, &r);
+    bigint_sub(&expected, &x, &basis.tree[0]);
+    check("Values wrap around at half the modulus", ok && same(&y, &expected));
+
+    // values beyond M are taken modulo M
+    bigint_mul(&x, &basis.tree[0], &basis.tree[0]);
+    naive_add(&x, 12345);
+    bigint_rns_from_bigint(&r, &x);
+    bigint_rns_to_bigint(&y, &r);
+    check("Conversion reduces modulo the basis", bigint_isequal_uint32(y, 12345) && !y.is_negative);
+
+    // (1 - 2 + 3 - ... - 100) * 3^100 * 100! computed residue by residue
+    BigIntRns acc = bigint_rns_alloc(&basis);
+    BigIntRns term = bigint_rns_alloc(&basis);
+    bigint_rns_set_int64(&acc, 0);
+    for (int64_t i = 1; i <= 100; i++) {
+        bigint_rns_set_int64(&term, i);
+        if (i % 2) {
+            bigint_rns_add(&acc, &acc, &term);
+        } else {
+            bigint_rns_sub(&acc, &acc, &term);
+        }
+    }
+    bigint_ui_pow_ui(&x, 3, 100);
+    bigint_rns_from_bigint(&term, &x);
+    bigint_rns_mul(&acc, &acc, &term);
+    bigint_set_int64(&expected, -50);
+    bigint_mul(&expected, &expected, &x);
+    for (int64_t i = 2; i <= 100; i++) {
+        bigint_rns_set_int64(&term, i);
+        bigint_rns_mul(&acc, &acc, &term);
+        naive_mult(&expected, (uint32_t)i);
+    }
+    bigint_rns_to_bigint(&y, &acc);
+    check("Chain of additions, subtractions and products", same(&y, &expected));
+
+    bigint_rns_set_int64(&acc, INT64_MIN);
+    bigint_rns_to_bigint(&y, &acc);
+    bigint_set_int64(&expected, INT64_MIN);
+    check("Smallest int64", same(&y, &expected));
+
+    check("Residue ranges on separate threads", chain_in_slices(&basis, 4) && chain_in_slices(&basis, 7));
+
+    bigint_rns_free(&r);
+    bigint_rns_free(&acc);
+    bigint_rns_free(&term);
+    bigint_rns_basis_free(&basis);
+
+    // a single prime has no tree to walk
+    bigint_rns_basis_init(&basis, 20);
+    r = bigint_rns_alloc(&basis);
+    BigIntRns s = bigint_rns_alloc(&basis);
+    bigint_set_int64(&x, -999);
+    bigint_rns_from_bigint(&r, &x);
+    bigint_rns_mul(&r, &r, &r);
+    bigint_rns_set_int64(&s, 1000000);
+    bigint_rns_sub(&r, &r, &s);
+    bigint_rns_to_bigint(&y, &r);
+    bigint_set_int64(&expected, -1999);
+    check("Single prime basis", basis.k == 1 && same(&y, &expected));
+    bigint_rns_free(&r);
+    bigint_rns_free(&s);
+    bigint_rns_basis_free(&basis);
+
+    bigint_free(&x);
+    bigint_free(&y);
+    bigint_free(&expected);
+    return failures != 0;
+}
@@ -68,12 +68,13 @@ int main() {
       "99999999999999999999999999999999999988888888888888888888888888888888",
       "11111111111111111111111111111112", false);
 
-  //
-  // test_add("Sub -ve from +ve number", "123", "-23", "100", false);
-  //
-  // test_add("Sub +ve from -ve number", "-123", "23", "100", false);
-  //
-  // test_add("Sub -ve from -ve number", "-123", "-23", "100", true);
+  test_sub("Sub -ve from +ve number", "123", "-23", "146", false);
+
+  test_sub("Sub +ve from -ve number", "-123", "23", "-146", true);
+
+  test_sub("Sub -ve from -ve number", "-123", "-23", "-100", true);
+
+  test_sub("Sub larger number from smaller number", "23", "123", "-100", true);
 
   return 0;
 }
@@ -0,0 +1,160 @@
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#define BIG_INT_IMPLEMENTATION
+#include "../../BigInt.h"
+#include "../test-check.h"
+
+static bool check_str(const char *what, BigInt n, const char *expected) {
+    char buf[255] = "";
+    bigint_to_dec_str(n, buf, sizeof(buf));
+    if (strcmp(buf, expected) == 0) return true;
+    printf_red("Error: %s mismatch.", what);
+    printf_red("Expected: \"%s\"", expected);
+    printf_red("Actual:   \"%s\"", buf);
+    return false;
+}
+
+static bool check_u64(const char *what, uint64_t actual, uint64_t expected) {
+    if (actual == expected) return true;
+    printf_red("Error: %s mismatch, expected %llu got %llu", what, (unsigned long long)expected,
+               (unsigned long long)actual);
+    return false;
+}
+
+static void report(bool ok) {
+    if (ok) {
+        printf_green("pass");
+    } else {
+        failures++;
+    }
+    printf("------------------------------\n\n");
+}
+
+void test_logic(char *a_str, char *b_str, const char *exp_and, const char *exp_or, const char *exp_xor) {
+    BigInt a = bigint_alloc();
+    BigInt b = bigint_alloc();
+    BigInt res = bigint_alloc();
+    bool ok = true;
+
+    bigint_set(&a, a_str);
+    bigint_set(&b, b_str);
+    printf("%s op %s\n", a_str, b_str);
+
+    bigint_and(&res, &a, &b);
+    ok &= check_str("and", res, exp_and);
+    bigint_or(&res, &a, &b);
+    ok &= check_str("or", res, exp_or);
+    bigint_xor(&res, &a, &b);
+    ok &= check_str("xor", res, exp_xor);
+
+    // in place on the first operand
+    bigint_xor(&a, &a, &b);
+    ok &= check_str("in place xor", a, exp_xor);
+
+    report(ok);
+    bigint_free(&a);
+    bigint_free(&b);
+    bigint_free(&res);
+}
+
+void test_bits(char *a_str, const char *exp_com, uint64_t exp_popcount, uint64_t exp_scan0, uint64_t exp_scan1_from_3,
+               uint64_t exp_scan1_from_40, bool exp_bit33, const char *exp_setbit70, const char *exp_clrbit1,
+               size_t exp_size10, size_t exp_size2, size_t exp_size16) {
+    BigInt a = bigint_alloc();
+    BigInt res = bigint_alloc();
+    bool ok = true;
+
+    bigint_set(&a, a_str);
+    printf("bits of %s\n", a_str);
+
+    bigint_com(&res, &a);
+    ok &= check_str("com", res, exp_com);
+    ok &= check_u64("popcount", bigint_popcount(&a), exp_popcount);
+    ok &= check_u64("scan0", bigint_scan0(&a, 0), exp_scan0);
+    ok &= check_u64("scan1 from 3", bigint_scan1(&a, 3), exp_scan1_from_3);
+    ok &= check_u64("scan1 from 40", bigint_scan1(&a, 40), exp_scan1_from_40);
+    ok &= check_u64("tstbit 33", bigint_tstbit(&a, 33), exp_bit33);
+    ok &= check_u64("size in base 2", bigint_sizeinbase(&a, 2), exp_size2);
+    ok &= check_u64("size in base 16", bigint_sizeinbase(&a, 16), exp_size16);
+    size_t size10 = bigint_sizeinbase(&a, 10);
+    if (size10 != exp_size10 && size10 != exp_size10 + 1) {
+        ok &= check_u64("size in base 10", size10, exp_size10);
+    }
+
+    bigint_deep_copy(&res, &a);
+    bigint_setbit(&res, 70);
+    ok &= check_str("setbit 70", res, exp_setbit70);
+    bigint_deep_copy(&res, &a);
+    bigint_clrbit(&res, 1);
+    ok &= check_str("clrbit 1", res, exp_clrbit1);
+
+    report(ok);
+    bigint_free(&a);
+    bigint_free(&res);
+}
+
+void test_hamdist(char *a_str, char *b_str, uint64_t expected) {
+    BigInt a = bigint_alloc();
+    BigInt b = bigint_alloc();
+
+    bigint_set(&a, a_str);
+    bigint_set(&b, b_str);
+    printf("hamdist(%s, %s)\n", a_str, b_str);
+    report(check_u64("hamdist", bigint_hamdist(&a, &b), expected));
+    bigint_free(&a);
+    bigint_free(&b);
+}
+
+int main() {
+    test_logic("123456789012345678901234567890", "123456789012345678901234567890", "123456789012345678901234567890", "123456789012345678901234567890", "0");
+    test_logic("123456789012345678901234567890", "-98765432109876543210", "123456788933793542183975452690", "-20213295392617428010", "-123456788954006837576592880700");
+    test_logic("123456789012345678901234567890", "4294967295", "1312754386", "123456789012345678904216780799", "123456789012345678902904026413");
+    test_logic("123456789012345678901234567890", "-4294967296", "123456789012345678899921813504", "-2982212910", "-123456789012345678902904026414");
+    test_logic("-98765432109876543210", "123456789012345678901234567890", "123456788933793542183975452690", "-20213295392617428010", "-123456788954006837576592880700");
+    test_logic("-98765432109876543210", "-98765432109876543210", "-98765432109876543210", "-98765432109876543210", "0");
+    test_logic("-98765432109876543210", "4294967295", "450461974", "-98765432106032037889", "-98765432106482499863");
+    test_logic("-98765432109876543210", "-4294967296", "-98765432110327005184", "-3844505322", "98765432106482499862");
+    test_logic("4294967295", "123456789012345678901234567890", "1312754386", "123456789012345678904216780799", "123456789012345678902904026413");
+    test_logic("4294967295", "-98765432109876543210", "450461974", "-98765432106032037889", "-98765432106482499863");
+    test_logic("4294967295", "4294967295", "4294967295", "4294967295", "0");
+    test_logic("4294967295", "-4294967296", "0", "-1", "-1");
+    test_logic("-4294967296", "123456789012345678901234567890", "123456789012345678899921813504", "-2982212910", "-123456789012345678902904026414");
+    test_logic("-4294967296", "-98765432109876543210", "-98765432110327005184", "-3844505322", "98765432106482499862");
+    test_logic("-4294967296", "4294967295", "0", "-1", "-1");
+    test_logic("-4294967296", "-4294967296", "-4294967296", "-4294967296", "0");
+    test_logic("0", "123456789012345678901234567890", "0", "123456789012345678901234567890", "123456789012345678901234567890");
+    test_logic("0", "-98765432109876543210", "0", "-98765432109876543210", "-98765432109876543210");
+    test_logic("0", "4294967295", "0", "4294967295", "4294967295");
+    test_logic("0", "-4294967296", "0", "-4294967296", "-4294967296");
+    test_logic("-1", "123456789012345678901234567890", "123456789012345678901234567890", "-1", "-123456789012345678901234567891");
+    test_logic("-1", "-98765432109876543210", "-98765432109876543210", "-1", "98765432109876543209");
+    test_logic("-1", "4294967295", "4294967295", "-1", "-4294967296");
+    test_logic("-1", "-4294967296", "-4294967296", "-1", "4294967295");
+    test_logic("340282366920938463463374607431768211455", "123456789012345678901234567890", "123456789012345678901234567890", "340282366920938463463374607431768211455", "340282366797481674451028928530533643565");
+    test_logic("340282366920938463463374607431768211455", "-98765432109876543210", "340282366920938463364609175321891668246", "-1", "-340282366920938463364609175321891668247");
+    test_logic("340282366920938463463374607431768211455", "4294967295", "4294967295", "340282366920938463463374607431768211455", "340282366920938463463374607427473244160");
+    test_logic("340282366920938463463374607431768211455", "-4294967296", "340282366920938463463374607427473244160", "-1", "-340282366920938463463374607427473244161");
+
+    test_bits("123456789012345678901234567890", "-123456789012345678901234567891", 54, 0, 4, 45, 1,
+              "123456789012345678901234567890", "123456789012345678901234567888", 30, 97, 25);
+    test_bits("-98765432109876543210", "98765432109876543209", UINT64_MAX, 0, 4, 41, 1,
+              "-98765432109876543210", "-98765432109876543212", 20, 67, 17);
+    test_bits("4294967295", "-4294967296", 32, 32, 3, UINT64_MAX, 0,
+              "1180591620721706270719", "4294967293", 10, 32, 8);
+    test_bits("-4294967296", "4294967295", UINT64_MAX, 0, 32, 40, 1,
+              "-4294967296", "-4294967296", 10, 33, 9);
+    test_bits("0", "-1", 0, 0, UINT64_MAX, UINT64_MAX, 0,
+              "1180591620717411303424", "0", 1, 1, 1);
+    test_bits("-1", "0", UINT64_MAX, UINT64_MAX, 3, 40, 1,
+              "-1", "-3", 1, 1, 1);
+    test_bits("340282366920938463463374607431768211455", "-340282366920938463463374607431768211456", 128, 128, 3, 40, 1,
+              "340282366920938463463374607431768211455", "340282366920938463463374607431768211453", 39, 128, 32);
+
+    test_hamdist("123456789012345678901234567890", "340282366920938463463374607431768211455", 74);
+    test_hamdist("-98765432109876543210", "-4294967296", 30);
+    test_hamdist("-98765432109876543210", "4294967296", UINT64_MAX);
+
+    return failures != 0;
+}
@@ -0,0 +1,101 @@
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#define BIG_INT_IMPLEMENTATION
+#include "../../BigInt.h"
+#include "../test-check.h"
+
+typedef struct {
+    uint64_t calls;
+    uint64_t last_done;
+    bool monotonic;
+    uint64_t stop_after;
+} ProgressLog;
+
+static bool log_progress(uint64_t done, uint64_t total, void *user) {
+    ProgressLog *log = (ProgressLog *)user;
+    if (done < log->last_done || done > total) log->monotonic = false;
+    log->last_done = done;
+    log->calls++;
+    return log->calls < log->stop_after;
+}
+
+int main() {
+    BigInt a = bigint_alloc();
+    BigInt b = bigint_alloc();
+    BigInt res = bigint_alloc();
+    bigint_ui_pow_ui(&a, 3, 300000);
+    bigint_ui_pow_ui(&b, 7, 150000);
+
+    // a deadline that has already passed stops the multiply at its first poll, however fast the machine
+    BigIntCtx ctx = {0};
+    ctx.deadline_ns = bigint_now_ns() - 1;
+    uint64_t start = bigint_now_ns();
+    BigIntStatus status = bigint_mul_ctx(&res, &a, &b, &ctx);
+    uint64_t elapsed_ms = (bigint_now_ns() - start) / 1000000;
+    printf("cancelled multiply returned after %llu ms\n", (unsigned long long)elapsed_ms);
+    check("Deadline cancels a large multiply", status == BIGINT_CANCELLED && elapsed_ms < 1000);
+    check("Cancelled multiply leaves zero", bigint_isequal_uint32(res, 0) && !res.is_negative);
+    bool clean = true;
+    for (size_t i = 0; i < res.capacity; i++) clean = clean && res.buf[i] == 0;
+    check("Cancelled multiply leaves no limbs above the size", clean);
+
+    // growing the zero result must not pick up stale partial product limbs
+    naive_add(&res, 0xFFFFFFFF);
+    naive_add(&res, 1);
+    naive_mult(&res, 2);
+    char small[32];
+    bigint_to_dec_str(res, small, sizeof(small));
+    check("Cancelled result grows like a fresh zero", strcmp(small, "8589934592") == 0);
+
+    // cancel flag raised before the call
+    atomic_bool cancel = true;
+    BigIntCtx flag_ctx = {0};
+    flag_ctx.cancel = &cancel;
+    check("Cancel flag stops division", bigint_divmod_ctx(&res, NULL, &a, &b, &flag_ctx) == BIGINT_CANCELLED);
+    check("Cancel flag stops squaring", bigint_mul_ctx(&res, &a, &a, &flag_ctx) == BIGINT_CANCELLED);
+    check("Cancel flag stops exponentiation", bigint_pow_ctx(&res, &b, 1000, &flag_ctx) == BIGINT_CANCELLED);
+
+    char *str = (char *)malloc(1000000);
+    check("Cancel flag stops decimal output",
+          bigint_to_dec_str_ctx(a, str, 1000000, &flag_ctx) == BIGINT_CANCELLED && str[0] == '\0');
+
+    // progress callback that aborts after a few reports
+    ProgressLog log = {0, 0, true, 5};
+    BigIntCtx progress_ctx = {0};
+    progress_ctx.progress = log_progress;
+    progress_ctx.user = &log;
+    status = bigint_mul_ctx(&res, &a, &b, &progress_ctx);
+    check("Progress callback can cancel", status == BIGINT_CANCELLED && log.calls == 5 && log.monotonic);
+
+    // a context with nothing set changes nothing
+    BigInt x = bigint_alloc();
+    BigInt y = bigint_alloc();
+    BigInt expected = bigint_alloc();
+    bigint_ui_pow_ui(&x, 3, 5000);
+    bigint_ui_pow_ui(&y, 11, 3000);
+    bigint_mul(&expected, &x, &y);
+    BigIntCtx idle = {0};
+    log = (ProgressLog){0, 0, true, UINT64_MAX};
+    idle.progress = log_progress;
+    idle.user = &log;
+    status = bigint_mul_ctx(&res, &x, &y, &idle);
+    size_t n = bigint_used(&expected);
+    check("Uncancelled multiply completes", status == BIGINT_OK && bigint_used(&res) == n &&
+                                                memcmp(res.buf, expected.buf, n * sizeof(uint32_t)) == 0);
+
+    status = bigint_divmod_ctx(&res, NULL, &expected, &y, &idle);
+    n = bigint_used(&x);
+    check("Uncancelled division completes", status == BIGINT_OK && bigint_used(&res) == n &&
+                                                memcmp(res.buf, x.buf, n * sizeof(uint32_t)) == 0);
+
+    free(str);
+    bigint_free(&a);
+    bigint_free(&b);
+    bigint_free(&res);
+    bigint_free(&x);
+    bigint_free(&y);
+    bigint_free(&expected);
+    return failures != 0;
+}
@@ -0,0 +1,107 @@
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#define BIG_INT_IMPLEMENTATION
+#include "../../BigInt.h"
+#include "../test-check.h"
+
+static bool equals(BigIntDec *num, const char *expected) {
+    static char buf[4096];
+    bigint_dec_to_str(num, buf, sizeof(buf));
+    if (strcmp(buf, expected) != 0) {
+        printf("got      %s\nexpected %s\n", buf, expected);
+        return false;
+    }
+    return true;
+}
+
+static void test_round_trip(const char *test_name, const char *input, const char *expected) {
+    BigIntDec num = bigint_dec_alloc();
+    bigint_dec_set(&num, input);
+    check(test_name, equals(&num, expected) && bigint_dec_digits(&num) == strlen(expected) - (expected[0] == '-'));
+    bigint_dec_free(&num);
+}
+
+static void test_add_sub(const char *test_name, const char *a_str, const char *b_str, const char *exp_sum,
+                         const char *exp_diff) {
+    BigIntDec a = bigint_dec_alloc();
+    BigIntDec b = bigint_dec_alloc();
+    BigIntDec res = bigint_dec_alloc();
+    bigint_dec_set(&a, a_str);
+    bigint_dec_set(&b, b_str);
+
+    bigint_dec_add(&res, &a, &b);
+    bool ok = equals(&res, exp_sum);
+    bigint_dec_sub(&res, &a, &b);
+    ok = equals(&res, exp_diff) && ok;
+    bigint_dec_sub(&a, &a, &b);
+    ok = equals(&a, exp_diff) && ok;
+    check(test_name, ok);
+
+    bigint_dec_free(&a);
+    bigint_dec_free(&b);
+    bigint_dec_free(&res);
+}
+
+int main() {
+    test_round_trip("Zero", "0", "0");
+    test_round_trip("Negative zero prints as zero", "-0", "0");
+    test_round_trip("Leading zeros are dropped", "000000000000123", "123");
+    test_round_trip("Largest single limb", "999999999", "999999999");
+    test_round_trip("Smallest two limb value", "1000000000", "1000000000");
+    test_round_trip("Zero limbs in the middle", "-1000000000000000000000000000000000000000001",
+                    "-1000000000000000000000000000000000000000001");
+
+    test_add_sub("Carry across limbs", "999999999999999999", "1", "1000000000000000000", "999999999999999998");
+    test_add_sub("Mixed signs", "-123456789000000000999999999123456789", "999999999000000001",
+                 "-123456789000000000000000000123456788", "-123456789000000001999999998123456790");
+    test_add_sub("Smaller magnitude first", "999999999000000001", "-123456789000000000999999999123456789",
+                 "-123456789000000000000000000123456788", "123456789000000001999999998123456790");
+    test_add_sub("Equal values", "-5000000000", "-5000000000", "-10000000000", "0");
+
+    BigIntDec a = bigint_dec_alloc();
+    BigIntDec b = bigint_dec_alloc();
+    bigint_dec_set(&a, "999999999999999999");
+    bigint_dec_mul_ui(&a, &a, 4294967295u);
+    check("Scalar multiply carries into new limbs", equals(&a, "4294967294999999995705032705"));
+    bigint_dec_set(&a, "-100000000000000000000000000000000000000000001");
+    bigint_dec_mul_ui(&b, &a, 3);
+    check("Scalar multiply keeps the sign", equals(&b, "-300000000000000000000000000000000000000000003"));
+    bigint_dec_mul_ui(&b, &a, 0);
+    check("Scalar multiply by zero", equals(&b, "0") && !b.is_negative);
+
+    bigint_dec_set(&a, "-1000000000");
+    bigint_dec_set(&b, "-999999999");
+    check("Compare negative values", bigint_dec_cmp(&a, &b) < 0 && bigint_dec_cmp(&b, &a) > 0);
+    bigint_dec_set(&b, "1");
+    check("Compare across signs", bigint_dec_cmp(&a, &b) < 0 && bigint_dec_cmp(&b, &b) == 0);
+
+    // conversions agree with the binary representation's own decimal output
+    BigInt bin = bigint_alloc();
+    BigInt back = bigint_alloc();
+    static char expected[4096];
+    bool ok = true;
+    for (uint64_t e = 0; e < 3000 && ok; e += 97) {
+        bigint_ui_pow_ui(&bin, 3, e);
+        bin.is_negative = e % 2;
+        bigint_to_dec_str(bin, expected, sizeof(expected));
+        bigint_dec_from_bigint(&a, &bin);
+        ok = equals(&a, expected);
+        bigint_dec_to_bigint(&back, &a);
+        ok = ok && bigint_hamdist(&back, &bin) == 0 && back.is_negative == bin.is_negative;
+    }
+    check("Conversion to and from BigInt", ok);
+
+    bigint_set_zero(&bin);
+    bigint_dec_from_bigint(&a, &bin);
+    bigint_dec_to_bigint(&back, &a);
+    check("Conversion of zero", equals(&a, "0") && bigint_isequal_uint32(back, 0));
+
+    bigint_free(&bin);
+    bigint_free(&back);
+    bigint_dec_free(&a);
+    bigint_dec_free(&b);
+
+    return failures != 0;
+}
@@ -0,0 +1,125 @@
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#define BIG_INT_IMPLEMENTATION
+#include "../../BigInt.h"
+#include "../test-check.h"
+
+static void load256(BigUInt256 *r, char *decimal) {
+    BigInt n = bigint_alloc();
+    bigint_set(&n, decimal);
+    biguint256_from_bigint(r, &n);
+    bigint_free(&n);
+}
+
+static void check256(const char *test_name, BigUInt256 *value, const char *expected) {
+    BigInt n = bigint_alloc();
+    char buf[255] = "";
+
+    biguint256_to_bigint(&n, value);
+    bigint_to_dec_str(n, buf, sizeof(buf));
+    printf("%s: %s\n", test_name, buf);
+    if (strcmp(expected, buf) == 0) {
+        printf_green("pass");
+    } else {
+        printf_red("Error: Output mismatch.");
+        printf_red("Expected: \"%s\"", expected);
+        printf_red("Actual:   \"%s\"", buf);
+        failures++;
+    }
+    printf("------------------------------\n\n");
+    bigint_free(&n);
+}
+
+// the bits set in the shift test value
+static bool marked_bit(uint32_t bit) {
+    return bit == 0 || bit == 31 || bit == 992 || bit == 1023;
+}
+
+int main() {
+    BigUInt256 a, b, lo, hi, max, one;
+
+    // a = 2^200 + 12345678901234567890, b = 3^150
+    load256(&a, "1606938044258990275541962092341162602522215339461694069869266");
+    load256(&b, "369988485035126972924700782451696644186473100389722973815184405301748249");
+    biguint256_mul_wide(&lo, &hi, &a, &b);
+    check256("Wide product low half", &lo,
+             "59651793526121868404076125841554704516669792823388891389388533630669391229570");
+    check256("Wide product high half", &hi, "5134621686652226692569600286659934398704129606032908974");
+
+    biguint256_mul(&lo, &a, &b);
+    check256("Truncated product", &lo,
+             "59651793526121868404076125841554704516669792823388891389388533630669391229570");
+
+    biguint256_set_zero(&max);
+    biguint256_set_uint64(&one, 1);
+    check("Subtract with borrow out", biguint256_sub(&max, &max, &one) == 1);
+    check256("Wraps to all ones", &max,
+             "115792089237316195423570985008687907853269984665640564039457584007913129639935");
+    biguint256_mul_wide(&lo, &hi, &max, &max);
+    check256("Square of max, low half", &lo, "1");
+    check256("Square of max, high half", &hi,
+             "115792089237316195423570985008687907853269984665640564039457584007913129639934");
+
+    biguint256_set_zero(&lo);
+    check("Add with carry out", biguint256_add(&lo, &max, &one) == 1 && biguint256_is_zero(&lo));
+
+    load256(&a, "123456789123456789123456789123456789");
+    biguint256_left_shift(&lo, &a, 100);
+    check256("Left shift across limbs", &lo, "156500072834599941898774713720503211228003138549903269485728497664");
+    biguint256_right_shift(&lo, &a, 70);
+    check256("Right shift across limbs", &lo, "104571967949794");
+    biguint256_left_shift(&lo, &a, 256);
+    check("Shift by full width clears", biguint256_is_zero(&lo));
+
+    BigUInt128 c;
+    BigInt n = bigint_alloc();
+    bigint_set(&n, "123456789123456789123456789123456789");
+    check("Value fits in 128 bits", biguint128_from_bigint(&c, &n));
+    biguint128_left_shift(&c, &c, 37);
+    biguint128_to_bigint(&n, &c);
+    char buf[255] = "";
+    bigint_to_dec_str(n, buf, sizeof(buf));
+    check("Left shift wraps modulo 2^128", strcmp(buf, "8469001949696274554085089544773828608") == 0);
+
+    bigint_set(&n, "-5");
+    BigUInt512 d, five;
+    biguint512_set_uint64(&five, 5);
+    check("Negative value reports no fit", !biguint512_from_bigint(&d, &n));
+    biguint512_add(&d, &d, &five);
+    check("Negative value loads as two's complement", biguint512_is_zero(&d));
+
+    BigUInt1024 e, f;
+    biguint1024_set_uint64(&e, 7);
+    biguint1024_left_shift(&f, &e, 1000);
+    check("Compare", biguint1024_cmp(&f, &e) == 1 && biguint1024_cmp(&e, &f) == -1 && biguint1024_cmp(&e, &e) == 0);
+
+    // a higher limb decides even when every lower limb points the other way
+    BigUInt1024 g;
+    for (int i = 0; i < BIGUINT1024_LIMBS; i++) {
+        f.limb[i] = i == 20 ? 1 : 0;
+        g.limb[i] = i < 20 ? UINT32_MAX : 0;
+    }
+    check("Compare is decided by the top differing limb", biguint1024_cmp(&f, &g) == 1 && biguint1024_cmp(&g, &f) == -1);
+
+    // every shift amount against one bit at a time, in place and out of place
+    bool ok = true;
+    for (uint32_t shift_by = 0; shift_by <= 1030 && ok; shift_by++) {
+        biguint1024_set_zero(&e);
+        e.limb[0] = 0x80000001u;
+        e.limb[31] = 0x80000001u;
+        biguint1024_left_shift(&f, &e, shift_by);
+        g = e;
+        biguint1024_right_shift(&g, &g, shift_by);
+        for (uint32_t bit = 0; bit < 1024 && ok; bit++) {
+            bool left = bit >= shift_by && marked_bit(bit - shift_by);
+            bool right = bit + shift_by < 1024 && marked_bit(bit + shift_by);
+            ok = (f.limb[bit / 32] >> bit % 32 & 1) == left && (g.limb[bit / 32] >> bit % 32 & 1) == right;
+        }
+    }
+    check("Shifts by every amount up to past the width", ok);
+
+    bigint_free(&n);
+    return failures != 0;
+}
@@ -0,0 +1,73 @@
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#define BIG_INT_IMPLEMENTATION
+#include "../../BigInt.h"
+#include "../test-check.h"
+
+int main() {
+    // reserve once, then grow a value to that size without another realloc
+    BigInt n = bigint_alloc();
+    bigint_set(&n, "1");
+    bigint_reserve(&n, 4096);
+    size_t reallocs = bigint_get_stats().reallocations;
+    uint32_t *buf = n.buf;
+    for (int i = 0; i < 4000; i++) {
+        naive_mult(&n, 2);
+    }
+    check("Reserved buffer is never reallocated", n.buf == buf && bigint_get_stats().reallocations == reallocs);
+    check("Reserved capacity holds the bits", n.capacity >= 4096 / 32 + 2);
+
+    // a large temporary that became small gives its memory back
+    BigIntStats before = bigint_get_stats();
+    BigInt tmp = bigint_alloc();
+    bigint_ui_pow_ui(&tmp, 3, 100000);
+    size_t big_cap = tmp.capacity;
+    bigint_set(&tmp, "12345");
+    bigint_shrink_to_fit(&tmp);
+    BigIntStats after = bigint_get_stats();
+    check("Shrink to fit keeps size < capacity", tmp.capacity == tmp.size + 1 && tmp.capacity < big_cap);
+    check("Shrink to fit returns memory", after.current_bytes < before.current_bytes + 1024);
+    check("Peak remembers the temporary", after.peak_bytes >= before.current_bytes + big_cap * sizeof(uint32_t));
+
+    char str[255] = "";
+    bigint_to_dec_str(tmp, str, sizeof(str));
+    check("Value survives shrinking", strcmp(str, "12345") == 0);
+
+    // a value that was never set still has room to become zero and grow
+    BigInt fresh = bigint_alloc();
+    bigint_shrink_to_fit(&fresh);
+    bigint_set(&fresh, "0");
+    naive_mult(&fresh, 10);
+    naive_add(&fresh, 7);
+    naive_mult(&fresh, 10);
+    check("Shrinking a fresh value leaves a spare limb", fresh.size < fresh.capacity && bigint_isequal_uint32(fresh, 70));
+    bigint_free(&fresh);
+
+    // shrinking a shared value detaches a right sized copy
+    BigInt shared = bigint_share(&n);
+    bigint_shrink_to_fit(&shared);
+    check("Shrinking a shared value leaves the other handle alone",
+          shared.buf != n.buf && n.capacity >= 4096 / 32 + 2 && !bigint_is_shared(&n) &&
+              memcmp(shared.buf, n.buf, n.size * sizeof(uint32_t)) == 0);
+
+    bigint_reset_peak_stats();
+    check("Peak reset starts from the current usage", bigint_get_stats().peak_bytes == bigint_get_stats().current_bytes);
+
+    // growth policy: 150% rounded up to 8 limbs
+    bigint_set_growth_policy(150, 8);
+    BigInt g = bigint_alloc();
+    size_t cap = g.capacity;
+    bigint_expand(&g);
+    check("Growth policy factor and granularity", g.capacity == (cap * 3 / 2 + 7) / 8 * 8);
+    bigint_set_growth_policy(200, 1);
+
+    bigint_free(&n);
+    bigint_free(&tmp);
+    bigint_free(&shared);
+    bigint_free(&g);
+    check("Everything released", bigint_get_stats().current_bytes == 0);
+
+    return failures != 0;
+}
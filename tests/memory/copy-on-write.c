@@ -0,0 +1,102 @@
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#define BIG_INT_IMPLEMENTATION
+#include "../../BigInt.h"
+#include "../test-check.h"
+
+static bool equals_str(BigInt n, const char *expected) {
+    char buf[255] = "";
+    bigint_to_dec_str(n, buf, sizeof(buf));
+    return strcmp(buf, expected) == 0;
+}
+
+int main() {
+    char big[] = "123456789012345678901234567890123456789012345678901234567890";
+
+    BigInt a = bigint_alloc();
+    bigint_set(&a, big);
+
+    BigInt b = bigint_share(&a);
+    check("Share aliases the buffer", b.buf == a.buf && bigint_is_shared(&a) && bigint_is_shared(&b));
+
+    naive_add(&b, 10);
+    check("Mutation detaches the writer", b.buf != a.buf && !bigint_is_shared(&a) && !bigint_is_shared(&b));
+    check("Original is untouched", equals_str(a, big));
+    check("Copy sees its own write",
+          equals_str(b, "123456789012345678901234567890123456789012345678901234567900"));
+
+    BigInt cache[4];
+    for (int i = 0; i < 4; i++) {
+        cache[i] = bigint_share(&a);
+    }
+    bigint_free(&a);
+    check("Buffer outlives the original handle", equals_str(cache[3], big));
+    for (int i = 0; i < 4; i++) {
+        bigint_free(&cache[i]);
+    }
+
+    BigInt c = bigint_alloc();
+    bigint_set(&c, "42");
+    bigint_shallow_copy(&c, &b);
+    check("Shallow copy releases old buffer and shares", c.buf == b.buf && bigint_is_shared(&b));
+    bigint_left_shift(&c, 1);
+    check("Shift on shared copy leaves source alone",
+          equals_str(b, "123456789012345678901234567890123456789012345678901234567900"));
+
+    // deep copy of a value larger than the destination capacity
+    BigInt huge = bigint_alloc();
+    BigInt small = bigint_alloc();
+    bigint_ui_pow_ui(&huge, 3, 2000);
+    bigint_set(&huge, "-98765432109876543210987654321098765432109876543210987654321098765432109876543210");
+    bigint_ui_pow_ui(&small, 7, 3);
+    bigint_deep_copy(&small, &huge);
+    check("Deep copy grows destination and copies sign",
+          small.capacity >= small.size && equals_str(small, "-98765432109876543210987654321098765432109876543210987654321098765432109876543210"));
+
+    BigInt d = bigint_alloc();
+    bigint_set(&d, "987654321987654321");
+    char buf[255] = "";
+    bigint_to_dec_str(d, buf, sizeof(buf));
+    check("Decimal conversion does not consume its input", equals_str(d, "987654321987654321"));
+
+    // a freed value and a zero initialised one have no buffer and get one on first write
+    BigInt freed = bigint_alloc();
+    bigint_set(&freed, "5");
+    bigint_free(&freed);
+    bigint_deep_copy(&freed, &d);
+    BigInt zeroed = {0};
+    bigint_deep_copy(&zeroed, &d);
+    check("Deep copy into a freed or zeroed value", equals_str(freed, "987654321987654321") &&
+                                                        equals_str(zeroed, "987654321987654321"));
+    bigint_free(&freed);
+    bigint_free(&zeroed);
+
+    BigInt x = bigint_alloc();
+    bigint_set(&x, "-123456789123456789123");
+    bigint_add(&freed, &d, &x);
+    BigInt z = {0};
+    bigint_add(&z, &d, &x);
+    check("Add into a freed or zeroed value", equals_str(freed, "-122469134801469134802") &&
+                                                  equals_str(z, "-122469134801469134802"));
+    bigint_free(&freed);
+    bigint_free(&z);
+
+    BigInt w = {0};
+    bigint_mul(&freed, &d, &x);
+    bigint_mul(&w, &d, &x);
+    check("Multiply into a freed or zeroed value",
+          equals_str(freed, "-121932631356500531468684650717116750483") &&
+              equals_str(w, "-121932631356500531468684650717116750483"));
+
+    bigint_free(&freed);
+    bigint_free(&w);
+    bigint_free(&x);
+    bigint_free(&b);
+    bigint_free(&c);
+    bigint_free(&d);
+    bigint_free(&huge);
+    bigint_free(&small);
+    return failures != 0;
+}
@@ -0,0 +1,119 @@
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#define BIG_INT_IMPLEMENTATION
+#include "../../BigInt.h"
+#include "../test-check.h"
+
+typedef void (*const_fn)(BigInt *dst, uint64_t digits, unsigned threads);
+
+void test_const(const char *test_name, const_fn fn, uint64_t digits, unsigned threads, const char *expected) {
+    BigInt n = bigint_alloc();
+    char buf[1024] = "";
+
+    fn(&n, digits, threads);
+    bigint_to_dec_str(n, buf, sizeof(buf));
+    printf("%s (%lu digits, %u threads)\n%s\n", test_name, (unsigned long)digits, threads, buf);
+
+    if (strcmp(expected, buf) == 0) {
+        printf_green("pass");
+    } else {
+        printf_red("Error: Output mismatch.");
+        printf_red("Expected: \"%s\"", expected);
+        failures++;
+    }
+    printf("------------------------------\n\n");
+    bigint_free(&n);
+}
+
+// harmonic numbers through the generic engine: H(n) = sum 1/k = T / (B * Q) with p = q = 1
+static void harmonic_term(uint64_t n, BigInt *p, BigInt *q, BigInt *a, BigInt *b, void *user) {
+    (void)user;
+    bigint_set_uint64(p, 1);
+    bigint_set_uint64(q, 1);
+    bigint_set_uint64(a, 1);
+    bigint_set_uint64(b, n);
+}
+
+void test_harmonic(void) {
+    BigIntSeries series = {harmonic_term, NULL, true, 2};
+    BigInt Q = bigint_alloc();
+    BigInt B = bigint_alloc();
+    BigInt T = bigint_alloc();
+    char num[255] = "", den[255] = "";
+
+    bigint_binsplit(&series, 1, 11, NULL, &Q, &B, &T);
+    bigint_mul(&B, &B, &Q);
+    bigint_to_dec_str(T, num, sizeof(num));
+    bigint_to_dec_str(B, den, sizeof(den));
+    printf("Harmonic number H(10) = %s / %s\n", num, den);
+
+    // H(10) = 7381 / 2520, the engine leaves the fraction unreduced with denominator 10!
+    if (strcmp(num, "10628640") == 0 && strcmp(den, "3628800") == 0) {
+        printf_green("pass");
+    } else {
+        printf_red("Error: expected 10628640 / 3628800");
+        failures++;
+    }
+    printf("------------------------------\n\n");
+    bigint_free(&Q);
+    bigint_free(&B);
+    bigint_free(&T);
+}
+
+// bigint_sqrt is what the pi driver uses for sqrt(10005), check it at the 64 bit edges too
+void test_sqrt(const char *input, const char *expected) {
+    BigInt a = bigint_alloc();
+    BigInt root = bigint_alloc();
+    char buf[64] = "";
+    bigint_set(&a, (char *)input);
+    bigint_sqrt(&root, &a);
+    bigint_to_dec_str(root, buf, sizeof(buf));
+    printf("sqrt(%s) = %s\n", input, buf);
+    if (strcmp(buf, expected) == 0) {
+        printf_green("pass");
+    } else {
+        printf_red("Error: expected %s", expected);
+        failures++;
+    }
+    printf("------------------------------\n\n");
+    bigint_free(&a);
+    bigint_free(&root);
+}
+
+int main() {
+    const char *pi =
+        "31415926535897932384626433832795028841971693993751058209749445923078164062862089"
+        "98628034825342117067982148086513282306647093844609550582231725359408128481117450"
+        "28410270193852110555964462294895493038196442881097566593344612847564823378678316"
+        "52712019091456485669234603486104543266482133936072602491412737245870066063155881"
+        "74881520920962829254091715364367892590360011330530548820466521384146951941511609"
+        "43305727036575959195309218611738193261179310511854807446237996274956735188575272"
+        "489122793818301194912";
+    const char *e =
+        "27182818284590452353602874713526624977572470936999595749669676277240766303535475"
+        "94571382178525166427427466391932003059921817413596629043572900334295260595630738"
+        "13232862794349076323382988075319525101901157383418793070215408914993488416750924"
+        "4761460668082264800168477411853742345442437107539077744992069";
+    const char *ln2 =
+        "69314718055994530941723212145817656807550013436025525412068000949339362196969471"
+        "56058633269964186875420014810205706857336855202357581305570326707516350759619307"
+        "27570828371435190307038623891673471123350115364497955239120475172681574932065155"
+        "524734139525882950453007095326366642654104239157814952043740";
+
+    test_const("pi", bigint_const_pi, 500, 1, pi);
+    test_const("pi", bigint_const_pi, 500, 4, pi);
+    test_const("e", bigint_const_e, 300, 4, e);
+    test_const("ln2", bigint_const_ln2, 300, 4, ln2);
+    test_const("pi to zero digits", bigint_const_pi, 0, 1, "3");
+    test_harmonic();
+    test_sqrt("0", "0");
+    test_sqrt("1", "1");
+    test_sqrt("18446744073709551615", "4294967295");
+    test_sqrt("18446744073709551616", "4294967296");
+    test_sqrt("340282366920938463463374607431768211455", "18446744073709551615");
+    test_sqrt("100000000000000000000000000000000000000000", "316227766016837933199");
+
+    return failures != 0;
+}
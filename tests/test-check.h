@@ -0,0 +1,24 @@
+#ifndef TEST_CHECK_H
+#define TEST_CHECK_H
+
+#include <stdbool.h>
+#include <stdio.h>
+
+#include "ANSI-color-macros.h"
+
+// pass/fail reporting shared by the tests, main returns failures != 0. inline so a test
+// that reports through its own helpers does not warn about an unused check
+static int failures = 0;
+
+static inline void check(const char *test_name, bool ok) {
+    printf("%s\n", test_name);
+    if (ok) {
+        printf_green("pass");
+    } else {
+        printf_red("fail");
+        failures++;
+    }
+    printf("------------------------------\n\n");
+}
+
+#endif
@@ -0,0 +1,186 @@
+// measures on the current machine where each faster algorithm overtakes the simpler one it
+// replaces and writes the crossovers as a header that BigInt.h includes at compile time.
+// every threshold is found by timing operands of n limbs once with the threshold out of reach
+// and once with the threshold at n, so the top level takes the faster algorithm and everything
+// below it runs as it would with the threshold in place.
+//
+// usage: bigint-tune [output header, default bigint_tuned.h]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BIG_INT_IMPLEMENTATION
+#include "../BigInt.h"
+
+// sizes grow by an eighth per step, a crossover has to hold for this many steps in a row
+#define TUNE_CONFIRM_STEPS 3
+#define TUNE_RUNS 5
+#define TUNE_MIN_RUN_NS 1000000ULL
+
+typedef struct {
+    BigIntThreshold which;
+    const char *what;
+    size_t min_limbs;
+    size_t max_limbs;
+    void (*setup)(size_t n);
+    void (*run)(void);
+} TuneCase;
+
+static uint32_t *tune_a, *tune_b, *tune_r;
+static size_t tune_n;
+static BigInt tune_num, tune_den, tune_quo, tune_rem;
+static BigIntDivisor tune_div;
+
+static uint32_t random_limb(void) {
+    static uint64_t state = 88172645463325252ULL;
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return (uint32_t)state;
+}
+
+static void random_limbs(uint32_t *a, size_t n) {
+    for (size_t i = 0; i < n; i++) a[i] = random_limb();
+}
+
+static void setup_mul(size_t n) {
+    tune_n = n;
+    random_limbs(tune_a, n);
+    random_limbs(tune_b, n);
+}
+
+static void run_mul(void) {
+    bigint_limbs_mul(tune_r, tune_a, tune_n, tune_b, tune_n, NULL);
+}
+
+static void run_sqr(void) {
+    bigint_limbs_sqr(tune_r, tune_a, tune_n, NULL);
+}
+
+// 2n by n limb division, the divisor is prepared after the threshold is set
+static void setup_div(size_t n) {
+    bigint_divisor_free(&tune_div);
+    bigint_reserve_limbs(&tune_den, n);
+    random_limbs(tune_den.buf, n);
+    tune_den.buf[n - 1] |= 1;
+    bigint_set_used(&tune_den, n);
+    bigint_reserve_limbs(&tune_num, 2 * n);
+    random_limbs(tune_num.buf, 2 * n);
+    tune_num.buf[2 * n - 1] |= 1;
+    bigint_set_used(&tune_num, 2 * n);
+    bigint_divisor_init(&tune_div, &tune_den);
+}
+
+static void run_div(void) {
+    bigint_divmod_pre(&tune_quo, &tune_rem, &tune_num, &tune_div);
+}
+
+// fastest of a few runs in nanoseconds per call, each run repeats the operation for a millisecond
+static double time_case(const TuneCase *c) {
+    double best = 0;
+    for (int run = 0; run < TUNE_RUNS; run++) {
+        uint64_t calls = 0;
+        uint64_t start = bigint_now_ns();
+        uint64_t elapsed;
+        do {
+            c->run();
+            calls++;
+            elapsed = bigint_now_ns() - start;
+        } while (elapsed < TUNE_MIN_RUN_NS);
+        double per_call = (double)elapsed / (double)calls;
+        if (run == 0 || per_call < best) best = per_call;
+    }
+    return best;
+}
+
+// smallest size from which the faster algorithm wins TUNE_CONFIRM_STEPS sizes in a row,
+// SIZE_MAX when it never does up to max_limbs
+static size_t find_crossover(const TuneCase *c) {
+    size_t first_win = SIZE_MAX;
+    int wins = 0;
+    for (size_t n = c->min_limbs; n <= c->max_limbs; n += n / 8 > 0 ? n / 8 : 1) {
+        bigint_set_threshold(c->which, SIZE_MAX);
+        c->setup(n);
+        double slow = time_case(c);
+        bigint_set_threshold(c->which, n);
+        c->setup(n);
+        double fast = time_case(c);
+        printf("%-14s %6zu limbs %12.0f ns %12.0f ns  %5.2fx\n", c->what, n, slow, fast, slow / fast);
+        fflush(stdout);
+
+        if (fast < slow) {
+            if (wins++ == 0) first_win = n;
+            if (wins == TUNE_CONFIRM_STEPS) return first_win;
+        } else {
+            wins = 0;
+        }
+    }
+    return SIZE_MAX;
+}
+
+int main(int argc, char **argv) {
+    const char *path = argc > 1 ? argv[1] : "bigint_tuned.h";
+
+    // the cases run in order and each one is timed with the thresholds found before it
+    const TuneCase cases[] = {
+        {BIGINT_THRESHOLD_KARATSUBA_MUL, "karatsuba mul", 4, 256, setup_mul, run_mul},
+        {BIGINT_THRESHOLD_KARATSUBA_SQR, "karatsuba sqr", 4, 256, setup_mul, run_sqr},
+        {BIGINT_THRESHOLD_BARRETT, "barrett", 8, 4096, setup_div, run_div},
+    };
+    const size_t case_count = sizeof(cases) / sizeof(cases[0]);
+    size_t found[sizeof(cases) / sizeof(cases[0])];
+
+    size_t max_limbs = 0;
+    for (size_t i = 0; i < case_count; i++) {
+        if (cases[i].max_limbs > max_limbs) max_limbs = cases[i].max_limbs;
+    }
+    tune_a = (uint32_t *)malloc(max_limbs * sizeof(uint32_t));
+    tune_b = (uint32_t *)malloc(max_limbs * sizeof(uint32_t));
+    tune_r = (uint32_t *)malloc(2 * max_limbs * sizeof(uint32_t));
+    tune_num = bigint_alloc();
+    tune_den = bigint_alloc();
+    tune_quo = bigint_alloc();
+    tune_rem = bigint_alloc();
+    memset(&tune_div, 0, sizeof(tune_div));
+
+    printf("%-14s %12s %15s %15s\n", "", "size", "without", "with");
+    for (size_t i = 0; i < case_count; i++) {
+        found[i] = find_crossover(&cases[i]);
+        bigint_set_threshold(cases[i].which, found[i]);
+    }
+
+    FILE *out = fopen(path, "w");
+    if (out == NULL) {
+        fprintf(stderr, "cannot write %s\n", path);
+        return 1;
+    }
+    fprintf(out, "// generated by bigint-tune, rerun it when the machine, compiler or flags change\n");
+    for (size_t i = 0; i < case_count; i++) {
+        const char *name = bigint_threshold_name(cases[i].which);
+        fprintf(out, "\n#ifndef %s\n", name);
+        if (found[i] == SIZE_MAX) {
+            fprintf(out, "#define %s SIZE_MAX // no crossover up to %zu limbs\n", name, cases[i].max_limbs);
+        } else {
+            fprintf(out, "#define %s %zu\n", name, found[i]);
+        }
+        fprintf(out, "#endif\n");
+        if (found[i] == SIZE_MAX) {
+            printf("%s = SIZE_MAX\n", name);
+        } else {
+            printf("%s = %zu\n", name, found[i]);
+        }
+    }
+    fclose(out);
+    printf("wrote %s\n", path);
+
+    bigint_divisor_free(&tune_div);
+    bigint_free(&tune_num);
+    bigint_free(&tune_den);
+    bigint_free(&tune_quo);
+    bigint_free(&tune_rem);
+    free(tune_a);
+    free(tune_b);
+    free(tune_r);
+    return 0;
+}